@@ -35,11 +35,6 @@ class BarComponent : public Component {
      * Constructor
      */
     BarComponent();
-
-    /**
-     * \copydoc Component::Update()
-     */
-    virtual void Update(Game* g, GameObject* o, int delta);
 };
 
 }   // End namespace midistar
@@ -0,0 +1,56 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIDISTAR_BENCHMARK_H_
+#define MIDISTAR_BENCHMARK_H_
+
+#include <string>
+
+namespace midistar {
+
+/**
+ * The Benchmark class runs the Game headlessly over a sweep of synthetic MIDI
+ * files, for each game mode, and reports frame time against the number of
+ * song notes on screen.
+ *
+ * Files are generated with MidiFileGenerator, using the configured generator
+ * parameters. Only the notes per second is swept.
+ */
+class Benchmark {
+ public:
+    /**
+     * Runs the benchmark suite and writes the results to standard output.
+     *
+     * \return true for success. false for failure.
+     */
+    bool Run();
+
+ private:
+    static const int DEFAULT_FRAME_TIME = 16;  //!< Frame time used if max FPS
+                                                         //!< is not configured
+    static const int DRUM_HIGHEST_KEY = 57;  //!< Highest GM drum key we use
+    static const int DRUM_LOWEST_KEY = 35;  //!< Lowest GM drum key we use
+    static const int MAX_TICKS = 1000000;  //!< Stops runaway benchmarks
+
+    bool RunMode(const std::string& mode, double notes_per_second);  //!< Runs
+                                    //!< one game mode over one generated file
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_BENCHMARK_H_
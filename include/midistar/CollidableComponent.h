@@ -35,11 +35,6 @@ class CollidableComponent : public Component {
      * Constructor
      */
     CollidableComponent();
-
-    /**
-     * \copydoc Component::Update()
-     */
-    virtual void Update(Game* g, GameObject* o, int delta);
 };
 
 }   // End namespace midistar
@@ -19,11 +19,10 @@
 #ifndef MIDISTAR_COLLISIONHANDLERCOMPONENT_H_
 #define MIDISTAR_COLLISIONHANDLERCOMPONENT_H_
 
-#include <vector>
-
 #include "midistar/Component.h"
 #include "midistar/Game.h"
 #include "midistar/GameObject.h"
+#include "midistar/VerticalCollisionDetectorComponent.h"
 
 namespace midistar {
 
@@ -46,13 +45,15 @@ class CollisionHandlerComponent : public Component {
      * \param[in,out] g The Game being played.
      * \param[in,out] o The owner of the component.
      * \param[in] delta The time since last update.
-     * \param[in,out] colliding_with The objects colliding with the owner.
+     * \param[in] contacts The owner's collision detector, which holds the
+     * objects colliding with the owner and the contacts that have started and
+     * ended.
      */
     virtual void HandleCollisions(
             Game* g
             , GameObject* o
             , int delta
-            , const std::vector<GameObject*> colliding_with) = 0;
+            , const VerticalCollisionDetectorComponent& contacts) = 0;
 
     /**
      * \copydoc Component::Update()
@@ -34,8 +34,9 @@ typedef int ComponentType;
  * is made up of a collection of Components, that dictate its behaviour and
  * functionality.
  *
- * The Component class is an abstract base class, where deriving classes
- * implement component behvaiour.
+ * The Component class is a base class, where deriving classes implement
+ * component behvaiour. Some ComponentTypes are only tags or hold data, and
+ * have no behaviour (see IsUpdated()). They are never updated.
  */
 class Component {
  public:
@@ -57,10 +58,8 @@ class Component {
         , DELETE_OFFSCREEN
         , VERTICAL_COLLISION_DETECTOR
         , NOTE_COLLISION_HANDLER
-        , SHRINK_GROW_COMPONENT
         , RESIZE
         , SPRITE_ANIMATOR
-        , FADING_OUTLINE_EFFECT
         , DELAYED_COMPONENT
         , NUM_COMPONENTS
     };
@@ -77,6 +76,15 @@ class Component {
      */
     virtual ~Component();
 
+    /**
+     * Gets a readable name for a ComponentType.
+     *
+     * \param type The ComponentType.
+     *
+     * \return The name of the ComponentType.
+     */
+    static const char* GetTypeName(ComponentType type);
+
     /**
      * Gets the ComponentType of the derived class.
      *
@@ -85,15 +93,30 @@ class Component {
     ComponentType GetType();
 
     /**
-     * Updates the Component.
+     * Determines whether or not Components of a ComponentType have behaviour,
+     * and so need updating. Tag and data Components are not updated.
+     *
+     * \param type The ComponentType.
+     *
+     * \return True if Components of the type are updated. False otherwise.
+     */
+    static bool IsUpdated(ComponentType type);
+
+    /**
+     * Updates the Component. Tag and data Components don't need to override
+     * this, as they are never updated.
      *
      * \param[in,out] g The Game object in use.
      * \param[in,out] o The GameObject that owns the component.
      * \param delta Time since last game tick.
      */
-    virtual void Update(Game* g, GameObject* o, int delta) = 0;
+    virtual void Update(Game* g, GameObject* o, int delta);
 
  private:
+    static const char* const TYPE_NAMES[NUM_COMPONENTS];  //!< Holds type names
+    static const bool UPDATED[NUM_COMPONENTS];  //!< Determines if each type
+                                                        //!< has behaviour
+
     ComponentType type_;  //!< Holds the type of the component.
 };
 
@@ -25,6 +25,8 @@
 #include <CLI/CLI.hpp>
 #include <SFML/Graphics.hpp>
 
+#include "midistar/MidiFileGenerator.h"
+
 namespace midistar {
 
 /**
@@ -55,6 +57,21 @@ class Config {
      */
     bool GetAutomaticallyPlay();
 
+    /**
+     * Gets a bool indicating whether or not the benchmark suite should be run
+     * instead of the game.
+     *
+     * \return Benchmark setting.
+     */
+    bool GetBenchmark();
+
+    /**
+     * Gets the notes per second values that the benchmark suite sweeps over.
+     *
+     * \return Notes per second values.
+     */
+    std::vector<int> GetBenchmarkSweep();
+
     /**
      * Gets a bool indicating whether or not full-screen mode is enabled.
      *
@@ -69,6 +86,22 @@ class Config {
      */
     const std::string GetGameMode();
 
+    /**
+     * Gets the path to write a synthetic MIDI file to. If this is non-empty,
+     * the file is generated instead of running the game.
+     *
+     * \return Synthetic MIDI file path.
+     */
+    const std::string GetGenerateMidiFile();
+
+    /**
+     * Determines whether or not each tick handles input and spawns song notes
+     * before updating and drawing, rather than after.
+     *
+     * \return True if input is handled first. False otherwise.
+     */
+    bool GetInputFirst();
+
     /**
      * Gets the MIDI note re-mapping (if it exists) of a note played on an
      * instrument.
@@ -86,6 +119,15 @@ class Config {
      */
     int GetMaximumFramesPerSecond();
 
+    /**
+     * Gets the maximum number of extra update passes per tick for GameObjects
+     * spawned during the tick. GameObjects spawned beyond this budget are
+     * first updated in the next tick.
+     *
+     * \return Maximum spawn passes.
+     */
+    int GetMaximumSpawnPasses();
+
     /**
      * Gets the MIDI file channels to play.
      *
@@ -93,6 +135,13 @@ class Config {
      */
     std::vector<int> GetMidiFileChannels();
 
+    /**
+     * Gets the parameters used to generate synthetic MIDI files.
+     *
+     * \return MIDI file generator parameters.
+     */
+    MidiFileGenerator::Parameters GetMidiFileGeneratorParameters();
+
     /**
      * Gets the MIDI file name to be played by the player.
      *
@@ -124,6 +173,40 @@ class Config {
      */
     std::vector<int> GetMidiFileTracks();
 
+    /**
+     * Gets the MIDI input port channels to read channel messages from.
+     *
+     * \return MIDI input channels. -1 means every channel.
+     */
+    std::vector<int> GetMidiInChannels();
+
+    /**
+     * Gets the types of MIDI input port messages to drop (see
+     * MidiInputFilter::Init()).
+     *
+     * \return Names of ignored message types.
+     */
+    std::vector<std::string> GetMidiInIgnore();
+
+    /**
+     * Gets the MIDI note re-mapping (if it exists) of a note played on one of
+     * the MIDI input ports.
+     *
+     * \param port The index of the port in GetMidiInPorts().
+     * \param note The actual MIDI note played on the port.
+     * \return The MIDI note it is mapped to. If there is no re-mapping,
+     * returns the original note.
+     */
+    int GetMidiInPortNoteRemapping(int port, int note);
+
+    /**
+     * Gets the MIDI input ports to open. Each port is given as either a port
+     * number or part of a port name.
+     *
+     * \return MIDI input ports.
+     */
+    std::vector<std::string> GetMidiInPorts();
+
     /**
      * Gets the velocity of MIDI notes output by the game.
      *
@@ -131,6 +214,14 @@ class Config {
      */
     int GetMidiOutVelocity();
 
+    /**
+     * Determines whether or not notes from the MIDI input port are played as
+     * soon as they arrive, rather than when the game handles them.
+     *
+     * \return True if MIDI thru is enabled. False otherwise.
+     */
+    bool GetMidiThru();
+
     /**
      * Gets the fall speed multiplier. This affects the fall speed of song
      * notes.
@@ -139,6 +230,86 @@ class Config {
      */
     double GetFallSpeedMultiplier();
 
+    /**
+     * Gets a bool indicating whether or not falling song notes are drawn from
+     * a static vertex buffer (see NoteLayer), instead of being GameObjects
+     * for their whole fall.
+     *
+     * \return Note buffer setting.
+     */
+    bool GetNoteBuffer();
+
+    /**
+     * Gets the MIDI files to play in order, one after the other. If this is
+     * empty, only the MIDI file given by GetMidiFileName() is played.
+     *
+     * \return Playlist MIDI file names.
+     */
+    std::vector<std::string> GetPlaylist();
+
+    /**
+     * Gets a bool indicating whether or not frame times should be recorded
+     * and reported when the game finishes.
+     *
+     * \return Profile setting.
+     */
+    bool GetProfile();
+
+    /**
+     * Gets the path to record input to. If this is empty, input is not
+     * recorded.
+     *
+     * \return Input recording path.
+     */
+    const std::string GetRecordInput();
+
+    /**
+     * Gets the path to write offline rendered audio to. If set, the game is
+     * rendered offline instead of being played.
+     *
+     * \return WAV file path, or an empty string if not rendering audio.
+     */
+    const std::string GetRenderAudio();
+
+    /**
+     * Gets the time after the start of each tick by which it must be drawn.
+     * Input is sampled again just before drawing, once this time is reached.
+     *
+     * \return Render deadline in milliseconds. 0 disables late input sampling.
+     */
+    int GetRenderDeadline();
+
+    /**
+     * Gets the number of frames per second of offline renders.
+     *
+     * \return Render frame rate.
+     */
+    int GetRenderFramesPerSecond();
+
+    /**
+     * Gets the number of encoder threads used to write rendered frames.
+     *
+     * \return Number of encoder threads. 0 means one per hardware thread.
+     */
+    int GetRenderThreads();
+
+    /**
+     * Gets the path to write offline rendered video frames to. If set, the
+     * game is rendered offline instead of being played.
+     *
+     * \return PNG file name prefix, "-" for raw RGBA on standard output, or an
+     * empty string if not rendering.
+     */
+    const std::string GetRenderVideo();
+
+    /**
+     * Gets the path of an input recording to replay. If this is empty, live
+     * input is used.
+     *
+     * \return Input replay path.
+     */
+    const std::string GetReplayInput();
+
     /**
      * Gets the height of the screen.
      *
@@ -169,6 +340,14 @@ class Config {
      */
     bool GetShowThirdParty();
 
+    /**
+     * Determines whether or not the simulation runs on its own thread, at a
+     * fixed tick rate, while the window thread draws snapshots of it.
+     *
+     * \return True if the simulation has its own thread. False otherwise.
+     */
+    bool GetSimulationThread();
+
     /**
      * Gets the SoundFont path used to create MIDI sounds.
      *
@@ -176,6 +355,14 @@ class Config {
      */
     const std::string GetSoundFontPath();
 
+    /**
+     * Gets the number of simulation ticks per second when the simulation runs
+     * on its own thread (see GetSimulationThread()).
+     *
+     * \return Tick rate.
+     */
+    int GetTickRate();
+
     /**
      * Parses commandline arguments.
      *
@@ -186,6 +373,27 @@ class Config {
      */
     bool ParseOptions(int argc, char** argv);
 
+    /**
+     * Sets whether or not notes should be automatically played.
+     *
+     * \param auto_play Automatically play setting.
+     */
+    void SetAutomaticallyPlay(bool auto_play);
+
+    /**
+     * Sets the game mode name.
+     *
+     * \param game_mode Game mode.
+     */
+    void SetGameMode(const std::string& game_mode);
+
+    /**
+     * Sets the MIDI file name to be played.
+     *
+     * \param midi_file_name MIDI file name.
+     */
+    void SetMidiFileName(const std::string& midi_file_name);
+
  private:
     static const int MIDI_OUT_VELOCITY = 127;  //!< MIDI out velocity
     static const int MIDI_FILE_TICKS_PER_SPEED = 120;  //!< Number of MIDI file
@@ -199,24 +407,54 @@ class Config {
 
     std::string audio_driver_;  //!< Audio driver name
     bool auto_play_;  //!< Auto play setting
+    bool benchmark_;  //!< Runs the benchmark suite instead of the game
+    std::vector<int> benchmark_sweep_;  //!< Notes per second values to
+                                                                  //!< benchmark
     double fall_speed_multiplier_;  //!< Affects fall speed of notes
     bool full_screen_;  //!< Full-screen setting
     std::string game_mode_;  //!< Game mode name
+    std::string generate_midi_file_;  //!< Path to write a synthetic MIDI file
+    MidiFileGenerator::Parameters generator_params_;  //!< Synthetic MIDI file
+                                                                //!< parameters
+    bool input_first_;  //!< Handles input before updating each tick
     std::unordered_map<int, int> instrument_midi_remapping_;  //!< MIDI
                                     //!< remapping derived from commandline arg
     std::vector<int> instrument_midi_remapping_notes_;  //!< MIDI remapping
                                                            //!< commandline arg
     int keyboard_first_note_;  //!< The first MIDI note to map on the keyboard
     int max_frames_per_second_;  //!< Max FPS
+    int max_spawn_passes_;  //!< Max extra update passes for spawned objects
     std::vector<int> midi_file_channels_;  //!< MIDI file channels to play
     std::string midi_file_name_;  //!< MIDI file being played by user
     bool midi_file_repeat_;  //!< Continuously repeats MIDI file being played
     std::vector<int> midi_file_tracks_;  //!< MIDI tracks to play
+    std::vector<int> midi_in_channels_;  //!< MIDI input channels to read
+    std::vector<std::string> midi_in_ignore_;  //!< MIDI input message types
+                                                                  //!< to drop
+    std::unordered_map<int, std::unordered_map<int, int>>
+        midi_in_port_remapping_;  //!< Per-port MIDI remapping derived from
+                                                          //!< commandline arg
+    std::vector<int> midi_in_port_remapping_notes_;  //!< Per-port MIDI
+                                                  //!< remapping commandline arg
+    std::vector<std::string> midi_in_ports_;  //!< MIDI input ports to open
+    bool midi_thru_;  //!< Plays MIDI port notes as soon as they arrive
+    bool note_buffer_;  //!< Draws falling notes from a static vertex buffer
+    std::vector<std::string> playlist_;  //!< MIDI files to play in order
+    bool profile_;  //!< Records and reports frame times
+    std::string record_input_;  //!< Path to record input to
+    std::string render_audio_;  //!< Path to write rendered audio to
+    int render_deadline_;  //!< Time into each tick that input is sampled again
+    int render_frames_per_second_;  //!< Offline render frame rate
+    int render_threads_;  //!< Offline render encoder threads
+    std::string render_video_;  //!< Path to write rendered frames to
+    std::string replay_input_;  //!< Path of input recording to replay
     int screen_height_;  //!< Screen height
     int screen_width_;  //!< Screen width
     bool show_third_party_;  //!< Determines whether or not to print out third-
                                                     //!< party copyright notices
+    bool simulation_thread_;  //!< Runs the simulation on its own thread
     std::string soundfont_path_;  //!< Path of SoundFont file for MIDI notes
+    int tick_rate_;  //!< Simulation ticks per second on its own thread
 };
 
 }   // End namespace midistar
@@ -0,0 +1,88 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIDISTAR_CONTACTSPAN_H_
+#define MIDISTAR_CONTACTSPAN_H_
+
+#include <cstddef>
+
+#include "midistar/GameObject.h"
+
+namespace midistar {
+
+/**
+ * The ContactSpan class is a non-owning view of a range of GameObjects held by
+ * a VerticalCollisionDetectorComponent. It is only valid until the detector
+ * next updates.
+ */
+class ContactSpan {
+ public:
+    /**
+     * Constructor.
+     *
+     * \param begin The first GameObject in the range.
+     * \param end One past the last GameObject in the range.
+     */
+    ContactSpan(GameObject* const* begin, GameObject* const* end);
+
+    /**
+     * Gets the first GameObject in the range.
+     *
+     * \return Iterator to the first GameObject.
+     */
+    GameObject* const* begin() const;
+
+    /**
+     * Determines whether or not a GameObject is in the range.
+     *
+     * \param o The GameObject to look for. It is only compared, so it may have
+     * been deleted.
+     *
+     * \return True if o is in the range. False otherwise.
+     */
+    bool Contains(const GameObject* o) const;
+
+    /**
+     * Gets one past the last GameObject in the range.
+     *
+     * \return Iterator to one past the last GameObject.
+     */
+    GameObject* const* end() const;
+
+    /**
+     * Gets the number of GameObjects in the range.
+     *
+     * \return Number of GameObjects.
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * Determines whether or not the range is empty.
+     *
+     * \return True if there are no GameObjects in the range. False otherwise.
+     */
+    bool IsEmpty() const;
+
+ private:
+    GameObject* const* begin_;  //!< First GameObject in the range
+    GameObject* const* end_;  //!< One past the last GameObject in the range
+};
+
+}   // End namespace midistar
+
+#endif  // MIDISTAR_CONTACTSPAN_H_
@@ -24,6 +24,7 @@
 
 #include "midistar/GameObject.h"
 #include "midistar/GameObjectFactory.h"
+#include "midistar/MidiFileIn.h"
 
 namespace midistar {
 
@@ -33,15 +34,29 @@ namespace midistar {
  */
 class DefaultGameObjectFactory : public GameObjectFactory {
  public:
+    static constexpr const char* MODE_NAME = "default";  //!< Game mode name
+
     /**
      * Constructor
      */
     explicit DefaultGameObjectFactory(double note_speed);
 
+    /**
+     * Creates a DefaultGameObjectFactory for a song (see GameModes).
+     *
+     * \param note_speed Used to calculate the falling speed of notes.
+     * \param file The MIDI file of the song.
+     *
+     * \return The new GameObjectFactory.
+     */
+    static GameObjectFactory* Create(double note_speed, const MidiFileIn&
+            file);
+
     /**
      * \copydoc GameObjectFactory::CreateNotePlayEffect()
      */
-    virtual GameObject* CreateNotePlayEffect(GameObject* o);
+    virtual bool CreateNotePlayEffect(GameObject* o, EffectSystem::Effect*
+            effect);
 
     /**
      * \copydoc GameObjectFactory::CreateInstrument()
@@ -74,6 +89,8 @@ class DefaultGameObjectFactory : public GameObjectFactory {
                                  //!< the instrument with the given MIDI key
     static void GetInstrumentKeyBinding(int midi_key, sf::Keyboard::Key* key,
             bool* ctrl, bool* shift);  //!< Gets instrument key binding
+    static double GetInstrumentY();  //!< Gets the Y position of the top of
+                                                            //!< the instrument
 
     double note_width_;  //!< Holds the width of song notes
 };
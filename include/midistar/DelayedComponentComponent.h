@@ -22,12 +22,16 @@
 #include "midistar/Component.h"
 #include "midistar/Game.h"
 #include "midistar/GameObject.h"
+#include "midistar/TimerWheel.h"
 
 namespace midistar {
 
 /**
  * The DelayedComponentComponent class allows a component to be added to the
  * owner after a supplied delay.
+ *
+ * The delay is scheduled on the Game's TimerWheel on the first update, and the
+ * component sleeps until it is due.
  */
 class DelayedComponentComponent : public Component {
  public:
@@ -39,6 +43,12 @@ class DelayedComponentComponent : public Component {
      */
     DelayedComponentComponent(Component* component, int delay);
 
+    /**
+     * Destructor. Cancels the delay, and deletes the component if it hasn't
+     * been added.
+     */
+    ~DelayedComponentComponent();
+
     /**
      * Sets the remaining delay until component is added.
      *
@@ -52,8 +62,15 @@ class DelayedComponentComponent : public Component {
     virtual void Update(Game* g, GameObject* o, int delta);
 
  private:
+    void AddComponent(GameObject* o);  //!< Adds the component to the owner
+    void ScheduleDelay();  //!< Schedules timer_ for the delay
+
     Component* component_;  //!< The component to add after the delay.
     int delay_;  //!< The delay before the component is added.
+    GameObject* owner_;  //!< The owner, once the delay is scheduled
+    int timer_;  //!< Holds ID of the delay timer
+    TimerWheel* timers_;  //!< Holds the TimerWheel running timer_, or nullptr
+                                                  //!< if the delay isn't scheduled
 };
 
 }   // End namespace midistar
@@ -24,6 +24,7 @@
 
 #include "midistar/GameObject.h"
 #include "midistar/GameObjectFactory.h"
+#include "midistar/MidiFileIn.h"
 
 namespace midistar {
 
@@ -33,6 +34,8 @@ namespace midistar {
  */
 class DrumGameObjectFactory : public GameObjectFactory {
  public:
+    static constexpr const char* MODE_NAME = "drum";  //!< Game mode name
+
     /**
      * Constructor
      *
@@ -46,10 +49,29 @@ class DrumGameObjectFactory : public GameObjectFactory {
             , const std::vector<int>& song_notes
             , double max_note_duration);
 
+    /**
+     * Creates a DrumGameObjectFactory for a song (see GameModes). There is a
+     * drum for each unique note in the song.
+     *
+     * \param note_speed The falling speed of notes.
+     * \param file The MIDI file of the song.
+     *
+     * \return The new GameObjectFactory.
+     */
+    static GameObjectFactory* Create(double note_speed, const MidiFileIn&
+            file);
+
+    /**
+     * \copydoc GameObjectFactory::AnimateNotePlayEffect()
+     */
+    virtual void AnimateNotePlayEffect(TweenSystem* tweens, EffectSystem*
+            effects, int effect);
+
     /**
      * \copydoc GameObjectFactory::CreateNotePlayEffect()
      */
-    virtual GameObject* CreateNotePlayEffect(GameObject* o);
+    virtual bool CreateNotePlayEffect(GameObject* o, EffectSystem::Effect*
+            effect);
 
     /**
      * \copydoc GameObjectFactory::CreateInstrument()
@@ -66,13 +88,39 @@ class DrumGameObjectFactory : public GameObjectFactory {
             , int vel
             , double duration);
 
+    /**
+     * \copydoc GameObjectFactory::HasSameLayout()
+     */
+    virtual bool HasSameLayout(const GameObjectFactory& other) const;
+
     /**
      * \copydoc GameObjectFactory::Init()
      */
     virtual bool Init();
 
  private:
+    /**
+     * Holds the precomputed layout of a drum lane. There is a lane for each
+     * unique note in the song.
+     */
+    struct Lane {
+        sf::Color colour;  //!< Note colour and instrument outline colour
+        bool ctrl;  //!< Determines if the key binding uses the ctrl modifier
+        sf::Keyboard::Key key;  //!< Key binding, or sf::Keyboard::Unknown if
+                                     //!< the lane has no key (MIDI input only)
+        bool shift;  //!< Determines if the key binding uses the shift modifier
+        double x;  //!< X position of notes and the instrument
+    };
+
     static const sf::Color BACKGROUND_COLOUR;  //!< Background colour
+    static const int EFFECT_FADE_DURATION = 500;  //!< Play effect fade out
+                                                     //!< time in milliseconds
+    static const int EFFECT_FRAME_SIZE = 128;  //!< Play effect atlas frame
+                                                              //!< size
+    static constexpr float EFFECT_GROWTH = 1.25f;  //!< Play effect final size
+                                          //!< as a multiple of the note size
+    static const int EFFECT_GROW_DURATION = 150;  //!< Play effect growth time
+                                                          //!< in milliseconds
     static constexpr float DRUM_PADDING_PERCENT = 0.1f;  //!< Padding percentage
     static constexpr double MAX_DRUM_RADIUS_PERCENT = 0.1;  //!< Max radius of
           //!< drum notes and instruments as a percentage of the size of the
@@ -86,6 +134,7 @@ class DrumGameObjectFactory : public GameObjectFactory {
     static constexpr float NOTE_OUTLINE_THICKNESS = -3.0f;  //!< Outline
                                                     //!< thickness of notes
     static const int NUM_MIDI_KEYS = 128;  //!< Maximum MIDI key
+    static const int NO_LANE = -1;  //!< Lane index of notes not in the song
     static const sf::Color OUTLINE_COLOUR;  //!< Outline colour
 
     static const sf::Color DRUM_COLOURS[NUM_DRUM_COLOURS];  //!< Holds drum
@@ -93,14 +142,13 @@ class DrumGameObjectFactory : public GameObjectFactory {
 
     GameObject* CreateInstrumentNote(int midi_key);  //!< Creates a note for
                                  //!< the instrument with the given MIDI key
-    void GetInstrumentKeyBinding(int midi_key, sf::Keyboard::Key* key,
-            bool* ctrl, bool* shift);  //!< Gets instrument key binding
-    int GetNoteUniqueIndex(int note);  //!< Gets MIDI note index in list of
-                                                 //!< unique notes for the song
-    double GetXPosition(int note);  //!< Gets the X position of a song
-                                                         //!< note / instrument
+    const Lane& GetLane(int note) const;  //!< Gets the lane of a MIDI note
+    void InitLanes();  //!< Builds the lane table and the layout of each lane
 
     double drum_radius_;  //!< Holds the radius of drum notes / instruments
+    int lane_index_[NUM_MIDI_KEYS];  //!< Lane index of each MIDI key, or
+                                      //!< NO_LANE if it is not in the song
+    std::vector<Lane> lanes_;  //!< Layout of each lane, in song_notes_ order
     std::vector<int> song_notes_;  //!< Unique MIDI notes in the song
     double x_pos_offset_;  //!< Defines offset for X coord for note and
                                                                 //!< instruments
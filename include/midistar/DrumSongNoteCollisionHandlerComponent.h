@@ -19,8 +19,6 @@
 #ifndef MIDISTAR_DRUMSONGNOTECOLLISIONHANDLERCOMPONENT_H_
 #define MIDISTAR_DRUMSONGNOTECOLLISIONHANDLERCOMPONENT_H_
 
-#include <vector>
-
 #include "midistar/CollisionHandlerComponent.h"
 
 namespace midistar {
@@ -43,11 +41,12 @@ class DrumSongNoteCollisionHandlerComponent : public CollisionHandlerComponent {
              Game* g
              , GameObject* o
              , int delta
-             , std::vector<GameObject*> colliding_with);
+             , const VerticalCollisionDetectorComponent& contacts);
 
  private:
-    bool HandleCollision(Game* g, GameObject* o, GameObject* collider);
-               //!< Handles a collision returns true if it's a valid collision
+    bool HandleCollision(Game* g, GameObject* o, GameObject* collider, double*
+            due_time);  //!< Handles a collision returns true if it's a valid
+              //!< collision, with the time the note reached the instrument
 };
 
 }  // End namespace midistar
@@ -0,0 +1,167 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDISTAR_EFFECTSYSTEM_H_
+#define MIDISTAR_EFFECTSYSTEM_H_
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace midistar {
+
+/**
+ * The EffectSystem class animates and draws short-lived visual effects, such
+ * as the effects shown when a note is played.
+ *
+ * Effects are not GameObjects. All effects are kept in one contiguous buffer,
+ * are advanced in a single loop each tick, and are drawn with a single draw
+ * call using frames from one texture atlas. The atlas is a grid of square
+ * frames; each row holds the frames of one animation.
+ *
+ * Effects only step through their animation frames by themselves. They are
+ * faded and resized by tweens (see TweenSystem).
+ *
+ * The atlas texture is only created when effects are first drawn, on the
+ * drawing thread, so games that never draw don't need a graphics context.
+ */
+class EffectSystem {
+ public:
+    static const int NO_EFFECT = -1;  //!< Effect ID that refers to no effect
+
+    /**
+     * Describes a single effect.
+     */
+    struct Effect {
+        float x;  //!< X position of the top-left corner
+        float y;  //!< Y position of the top-left corner
+        float width;  //!< Width on screen
+        float height;  //!< Height on screen
+        sf::Color colour;  //!< Colour to multiply the atlas frame by
+        int row;  //!< Atlas row holding the effect's frames
+        int frame;  //!< Current frame in the atlas row
+        int num_frames;  //!< Number of frames in the atlas row
+        int ms_per_frame;  //!< Time each frame is shown for
+    };
+
+    /**
+     * Constructor.
+     */
+    EffectSystem();
+
+    /**
+     * Adds an effect.
+     *
+     * \param effect The effect to add.
+     *
+     * \return The effect ID, which can be used to remove the effect.
+     */
+    int Add(const Effect& effect);
+
+    /**
+     * Removes all effects.
+     */
+    void Clear();
+
+    /**
+     * Draws all effects in a single draw call.
+     *
+     * \param[in] target The render target to draw to.
+     */
+    void Draw(sf::RenderTarget* target);
+
+    /**
+     * Gets the texture atlas that effect vertices are mapped to, creating it
+     * if the atlas has changed. Only call this from the drawing thread.
+     *
+     * \return Effect atlas.
+     */
+    const sf::Texture& GetAtlas();
+
+    /**
+     * Gets a live effect, so that it can be changed.
+     *
+     * \param id The effect ID returned by Add().
+     *
+     * \return The effect.
+     */
+    Effect& Get(int id);
+
+    /**
+     * Gets the number of live effects.
+     *
+     * \return Number of effects.
+     */
+    int GetCount() const;
+
+    /**
+     * Builds one textured quad per live effect, as drawn by Draw().
+     *
+     * \param[out] vertices Holds the quads. Its storage is reused.
+     */
+    void GetVertices(sf::VertexArray* vertices) const;
+
+    /**
+     * Initialises the EffectSystem. The atlas is copied, and its texture is
+     * created the next time effects are drawn.
+     *
+     * \param atlas Image holding every effect animation frame.
+     * \param frame_size The width and height of each frame in the atlas.
+     */
+    void Init(const sf::Image& atlas, int frame_size);
+
+    /**
+     * Removes an effect. Any tweens of the effect must be removed first (see
+     * TweenSystem::Remove()); Game::RemoveEffect() does both. Effects that a
+     * tween fades out are removed automatically, so their IDs must not be
+     * used after they have faded.
+     *
+     * \param id The effect ID returned by Add().
+     */
+    void Remove(int id);
+
+    /**
+     * Advances the animation of all effects.
+     *
+     * \param delta The time in milliseconds since the last tick.
+     */
+    void Update(int delta);
+
+ private:
+    /**
+     * Holds an effect and its bookkeeping.
+     */
+    struct Slot {
+        Effect effect;  //!< The effect
+        int frame_time;  //!< Time the current frame has been shown for
+        bool live;  //!< Determines if the slot holds an effect
+    };
+
+    sf::Texture atlas_;  //!< Holds every animation frame
+    bool atlas_changed_;  //!< Determines if atlas_ is older than atlas_image_
+    sf::Image atlas_image_;  //!< Holds every animation frame, off the GPU
+    int count_;  //!< Number of live effects
+    int frame_size_;  //!< Width and height of each atlas frame
+    std::vector<int> free_slots_;  //!< Indices of slots that can be reused
+    std::vector<Slot> slots_;  //!< Contiguous effect buffer
+    sf::VertexArray vertices_;  //!< Quads drawn each frame
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_EFFECTSYSTEM_H_
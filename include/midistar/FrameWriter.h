@@ -0,0 +1,119 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDISTAR_FRAMEWRITER_H_
+#define MIDISTAR_FRAMEWRITER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace midistar {
+
+/**
+ * The FrameWriter class writes rendered frames, either as a numbered PNG
+ * sequence or as raw RGBA to standard output.
+ *
+ * PNG frames are compressed and saved by a pool of encoder threads, so the
+ * caller can carry on rendering. Only a limited number of frames are queued;
+ * Write() blocks while the queue is full.
+ */
+class FrameWriter {
+ public:
+    /**
+     * Constructor.
+     */
+    FrameWriter();
+
+    /**
+     * Destructor. Waits for queued frames to be written.
+     */
+    ~FrameWriter();
+
+    /**
+     * Waits for all queued frames to be written and stops the encoder
+     * threads.
+     *
+     * \return true if every frame was written. false otherwise.
+     */
+    bool Finish();
+
+    /**
+     * Gets the number of frames passed to Write().
+     *
+     * \return Number of frames.
+     */
+    int GetFrameCount() const;
+
+    /**
+     * Initialises the FrameWriter.
+     *
+     * \param path The prefix of each PNG file name, which is followed by a
+     * zero-padded frame number. "-" writes raw RGBA frames to standard output.
+     * \param num_threads The number of encoder threads. 0 uses one thread per
+     * hardware thread.
+     *
+     * \return true for success. false for failure.
+     */
+    bool Init(const std::string& path, int num_threads);
+
+    /**
+     * Writes the next frame.
+     *
+     * \param frame The frame to write.
+     *
+     * \return true for success. false for failure.
+     */
+    bool Write(const sf::Image& frame);
+
+ private:
+    static const int FRAME_NUMBER_DIGITS = 6;  //!< Width of PNG frame numbers
+    static const int FRAMES_PER_THREAD = 2;  //!< Queued frames per thread
+
+    /**
+     * A frame waiting to be encoded.
+     */
+    struct Job {
+        int number;  //!< Frame number
+        sf::Image image;  //!< Frame contents
+    };
+
+    void EncodeFrames();  //!< Encoder thread loop
+    std::string GetFileName(int number) const;  //!< Gets a PNG file name
+
+    bool failed_;  //!< Determines if writing a frame failed
+    int frame_count_;  //!< Number of frames written
+    std::deque<Job> jobs_;  //!< Frames waiting to be encoded
+    std::condition_variable jobs_changed_;  //!< Signals queue changes
+    std::size_t max_jobs_;  //!< Maximum number of queued frames
+    std::mutex mutex_;  //!< Guards jobs_, failed_ and stopping_
+    std::string path_;  //!< PNG file name prefix, or "-"
+    bool raw_;  //!< Determines if frames are written raw to standard output
+    bool stopping_;  //!< Tells encoder threads to exit once the queue is empty
+    std::vector<std::thread> threads_;  //!< Encoder threads
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_FRAMEWRITER_H_
@@ -19,16 +19,30 @@
 #ifndef MIDISTAR_GAME_H_
 #define MIDISTAR_GAME_H_
 
-#include <queue>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <ostream>
+#include <string>
 #include <vector>
 #include <SFML/Graphics.hpp>
 
+#include "midistar/EffectSystem.h"
 #include "midistar/GameObject.h"
 #include "midistar/GameObjectFactory.h"
+#include "midistar/HitJudge.h"
+#include "midistar/InputLog.h"
 #include "midistar/MidiFileIn.h"
 #include "midistar/MidiMessage.h"
 #include "midistar/MidiOut.h"
 #include "midistar/MidiInstrumentIn.h"
+#include "midistar/NoteLayer.h"
+#include "midistar/Profiler.h"
+#include "midistar/RenderSnapshot.h"
+#include "midistar/SnapshotBuffer.h"
+#include "midistar/TimerWheel.h"
+#include "midistar/TweenSystem.h"
 
 namespace midistar {
 
@@ -39,6 +53,15 @@ class Game {
  public:
     /**
      * Constructor.
+     *
+     * \param headless Determines whether or not the game runs without a
+     * window. Headless games do not use MIDI ports or audio output, and only
+     * render if given a render target (see SetRenderTarget()).
+     */
+    explicit Game(bool headless);
+
+    /**
+     * Default constructor.
      */
     Game();
 
@@ -48,12 +71,40 @@ class Game {
     ~Game();
 
     /**
-     * Adds a new object to the game.
+     * Adds a new object to the game. The object is staged, and joins the game
+     * (receiving its first update) after the current update pass.
      *
      * \param obj The object to add.
      */
     void AddGameObject(GameObject* obj);
 
+    /**
+     * Finishes an offline audio render (see Config::GetRenderAudio()),
+     * letting playing notes fade out. Does nothing otherwise.
+     *
+     * \return true for success. false indicates that the audio render has
+     *         failed and the file is incomplete.
+     */
+    bool FinishAudioRender();
+
+    /**
+     * Gets the number of GameObjects in the Game that currently have a
+     * Component of the given type. Counts are kept up to date as Components
+     * are added and removed, so this is O(1).
+     *
+     * \param type The ComponentType to count.
+     *
+     * \return The number of Components of that type.
+     */
+    int GetComponentCount(ComponentType type);
+
+    /**
+     * Gets the EffectSystem used to show visual effects.
+     *
+     * \return EffectSystem instance.
+     */
+    EffectSystem& GetEffectSystem();
+
     /**
      * Gets the GameObjectFactory instance in use.
      *
@@ -68,6 +119,28 @@ class Game {
      */
     const std::vector<GameObject*>& GetGameObjects();
 
+    /**
+     * Gets the simulation time at which a MIDI input port message arrived,
+     * worked out from its timestamp rather than from when the game read it.
+     * While replaying or running headless, this is the current simulation
+     * time.
+     *
+     * \param msg MIDI message from GetMidiInMessages().
+     *
+     * \return Simulation time in milliseconds.
+     */
+    double GetInputTime(const MidiMessage& msg);
+
+    /**
+     * Gets the simulation time at which an SFML event arrived. SFML events
+     * are not timestamped, so this is when the events were polled.
+     *
+     * \param e SFML event from GetSfEvents().
+     *
+     * \return Simulation time in milliseconds.
+     */
+    double GetInputTime(const sf::Event& e);
+
     /**
      * Gets MIDI input port messages for the last tick.
      *
@@ -75,6 +148,13 @@ class Game {
      */
     const std::vector<MidiMessage>& GetMidiInMessages();
 
+    /**
+     * Gets the Profiler used to measure the game.
+     *
+     * \return Profiler instance.
+     */
+    Profiler& GetProfiler();
+
     /**
      * Gets SFML events for the last tick.
      *
@@ -82,6 +162,21 @@ class Game {
      */
     const std::vector<sf::Event>& GetSfEvents();
 
+    /**
+     * Gets the TimerWheel used to wait on deadlines. It advances at the start
+     * of each tick, before GameObjects are updated.
+     *
+     * \return TimerWheel instance.
+     */
+    TimerWheel& GetTimers();
+
+    /**
+     * Gets the TweenSystem used to animate GameObject properties.
+     *
+     * \return TweenSystem instance.
+     */
+    TweenSystem& GetTweens();
+
     /**
      * Gets the SFML window being used for rendering.
      *
@@ -97,10 +192,73 @@ class Game {
     bool Init();
 
     /**
-     * Runs the game.
+     * Determines whether or not notes from the MIDI input port are played as
+     * soon as they arrive (see Config::GetMidiThru()). If so, the game only
+     * shows and scores them.
+     *
+     * \return True if MIDI thru is in use. False otherwise.
+     */
+    bool IsMidiThru();
+
+    /**
+     * Determines whether or not the game is still running.
+     *
+     * \return True if the game is running. False if it has finished.
+     */
+    bool IsRunning();
+
+    /**
+     * Records that a song note has been hit by the player (or auto play). If
+     * a player pressed the instrument, the hit is judged early or late by
+     * comparing the time of the press with the time the note was due.
+     *
+     * \param instrument The instrument that hit the note.
+     * \param due_time Simulation time in milliseconds the note reached the
+     * instrument, or will reach it.
+     */
+    void RecordNoteHit(GameObject* instrument, double due_time);
+
+    /**
+     * Removes a visual effect along with its tweens. Effect IDs are reused,
+     * so effects must be removed this way rather than from the EffectSystem
+     * directly, or their tweens would carry on with the next effect added.
+     *
+     * \param effect The effect ID returned by EffectSystem::Add().
+     */
+    void RemoveEffect(int effect);
+
+    /**
+     * Runs the game until it finishes. Ticks use the real time between them,
+     * unless input is being replayed, in which case the recorded tick times
+     * are used.
+     *
+     * If Config::GetSimulationThread() is set, the game is ticked on its own
+     * thread at a fixed rate instead, and this thread only draws snapshots of
+     * it to the window.
      */
     void Run();
 
+    /**
+     * Sets the target that each tick is drawn to. By default, this is the
+     * window, or nothing for headless games.
+     *
+     * \param[in] target The render target, or nullptr to not draw.
+     */
+    void SetRenderTarget(sf::RenderTarget* target);
+
+    /**
+     * Stops the game. The window (if any) is closed, once the thread that
+     * draws to it sees the game has stopped.
+     */
+    void Stop();
+
+    /**
+     * Advances the game by one tick.
+     *
+     * \param delta The time in milliseconds since the last tick.
+     */
+    void Tick(int delta);
+
     /**
      * Turns off a MIDI note on the MIDI out port.
      *
@@ -119,20 +277,139 @@ class Game {
     void TurnMidiNoteOn(int chan, int note, int vel);
 
  private:
-    bool CheckSongNotes();  //!< Determines if the Game has valid song notes
+    static const std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+                                              //!< Initial state digest value
+    static const std::uint64_t FNV_PRIME = 1099511628211ULL;  //!< Multiplier
+                                                   //!< for state digest hashing
+
+    static const std::uint32_t LATCHED_COMPONENTS = 1u << Component::
+        INSTRUMENT_INPUT_HANDLER | 1u << Component::INVERT_COLOUR | 1u <<
+        Component::MIDI_NOTE;  //!< Components updated again for late input
+    static const int LOADING_BAR_HEIGHT = 20;  //!< Loading bar height
+    static constexpr float LOADING_BAR_OUTLINE_THICKNESS = 2.0f;  //!< Loading
+                                                 //!< bar outline thickness
+    static constexpr float LOADING_BAR_WIDTH = 0.5f;  //!< Loading bar width as
+                                         //!< a percentage of the screen width
+    static const int LOADING_POLL_TIME = 1;  //!< Time in milliseconds between
+                                   //!< checks on loads in headless games
+    static const sf::Int64 NO_INPUT = -1;  //!< Input time when there is no
+                                                       //!< input to be drawn
+
+    void CaptureSnapshot(RenderSnapshot* snapshot);  //!< Captures the tick
+                                                      //!< for the window thread
+    bool CheckSongNotes();  //!< Determines if the Game has song notes, staged
+                            //!< or committed
+    bool CheckSoundFont();  //!< Finishes the background SoundFont load if it
+                       //!< is done. Returns false if the load has failed
     void CleanUpObjects();  //!< Deletes all GameObjects and their components
+    int CountSongNotes();  //!< Counts the song notes in the Game
+    static bool IsQuitEvent(const sf::Event& e);  //!< Determines if an event
+                                                         //!< closes the game
+    void InitMidiThru();  //!< Plays MIDI thru notes on the instrument channel
+    void InitNoteLayer(NoteLayer* layer);  //!< Builds a NoteLayer for the
+                                             //!< current song, if enabled
+    template <typename T>
+    static bool IsReady(const T& f);  //!< Determines if a future
+                                     //!< for a background load is ready
+    void LatchInput(sf::Int64 tick_start);  //!< Waits for the render deadline
+                           //!< and handles input that arrived in the meantime
+    bool LoadSong(const std::string& file_name, MidiFileIn* file
+            , GameObjectFactory** factory);  //!< Loads a MIDI file and creates
+                                           //!< the GameObjectFactory for it
+    void PollInput();  //!< Takes MIDI port, window and replayed input
+    void PrepareNextSong();  //!< Starts loading the next playlist song in the
+                                                                //!< background
+    void RunSimulationThread();  //!< Ticks the game on its own thread, while
+                                          //!< this thread draws its snapshots
+    bool ShowLoadingScreen(int num_loaded, int num_loading);  //!< Draws load
+                      //!< progress. Returns false if the player closes the game
+    void WriteSessionSummary(std::ostream* out);  //!< Writes information to
+                                   //!< compare recorded and replayed sessions
+    double ClockToTime(double clock_time);  //!< Converts a MidiPortIn clock
+                                              //!< time to simulation time
     void DeleteObject(GameObject* o);  //!< Deletes a GameObject
-    void FlushNewObjectQueue();  //!< Adds new objects to object buffer
+    void FlushNewObjectQueue();  //!< Commits staged objects to object buffer
+    void InsertObject(GameObject* o);  //!< Adds a GameObject to the object
+                                       //!< buffer and counts its components
+    void Simulate();  //!< Ticks the game at a fixed rate until it finishes
+    void SpawnSongNotes(int due_until, int place_at);  //!< Creates the song
+                          //!< notes due by due_until, placed as at place_at
+    bool StartNextSong();  //!< Switches to the next playlist song. Returns
+                                     //!< false if there is no song to play
+    void UpdateCounters();  //!< Publishes component counts to the Profiler
 
+    int component_counters_[Component::NUM_COMPONENTS];  //!< Profiler
+                                           //!< counter IDs, indexed by type
+    int component_counts_[Component::NUM_COMPONENTS];  //!< Live Component
+                                                   //!< counts, indexed by type
+    EffectSystem effects_;  //!< Animates and draws visual effects
+    int effects_counter_;  //!< Profiler counter ID for live effects
+    std::mutex events_mutex_;  //!< Guards window_events_
+    int extra_passes_counter_;  //!< Profiler counter ID for spawn passes
+    bool first_frame_shown_;  //!< Determines if a frame has been displayed
+    bool headless_;  //!< Determines if the game runs without a window
+    HitJudge hit_judge_;  //!< Judges how early or late notes are hit
+    bool input_first_;  //!< Determines if input is handled before updating
+    InputLog input_log_;  //!< Holds recorded or replayed input
+    sf::Int64 input_time_;  //!< Time in microseconds the oldest input not yet
+                                        //!< drawn was taken, or NO_INPUT
+    int latency_counter_;  //!< Profiler counter ID for input latency
     GameObjectFactory* object_factory_;  //!< Holds GameObjectFactory instance
-    MidiFileIn midi_file_in_;  //!< MIDI file in instance
+    int midi_dropped_counter_;  //!< Profiler counter ID for dropped MIDI
+                                                  //!< input port messages
+    MidiFileIn* midi_file_in_;  //!< MIDI file in instance of current song
     std::vector<MidiMessage> midi_in_buf_;  //!< MIDI input port notes buffer
     MidiOut midi_out_;  //!< MIDI port out instance
-    MidiInstrumentIn midi_instrument_in_;  //!< MIDI instrument input
-    std::queue<GameObject*> new_objects_;  //!< New GameObjects buffer
+    MidiInstrumentIn midi_instrument_in_;  //!< MIDI instrument input. Declared
+                    //!< after midi_out_, so thru notes stop before it is gone
+    int midi_passed_counter_;  //!< Profiler counter ID for passed MIDI input
+                                                          //!< port messages
+    bool midi_thru_;  //!< Determines if MIDI port notes are played thru
+    std::vector<GameObject*> new_objects_;  //!< Staged GameObjects buffer
+    MidiFileIn* next_midi_file_in_;  //!< MIDI file in instance of next song
+    std::size_t next_note_;  //!< Index of the next note to spawn in the note
+                                            //!< schedule of the current song
+    GameObjectFactory* next_object_factory_;  //!< GameObjectFactory instance
+                                                             //!< of next song
+    std::future<bool> next_song_;  //!< Background load of the next song
+    NoteLayer note_layer_;  //!< Draws song notes before they are activated
+    int notes_hit_;  //!< Number of song notes hit
     std::vector<GameObject*> objects_;  //!< GameObjects buffer
+    std::vector<std::string> playlist_;  //!< MIDI files to play in order
+    std::vector<sf::Event> polled_events_;  //!< SFML events polled this tick
+    Profiler profiler_;  //!< Measures frame times
+    int render_deadline_;  //!< Time into each tick that input is taken again
+    sf::RenderTarget* render_target_;  //!< Target each tick is drawn to
+    bool record_input_;  //!< Determines if input is being recorded
+    bool replay_input_;  //!< Determines if input is being replayed
+    std::mutex resources_mutex_;  //!< Held while a snapshot is drawn, and
+                           //!< while the resources it refers to are replaced
+    std::atomic<bool> running_;  //!< Determines if the game is still running
     std::vector<sf::Event> sf_events_;  //!< SFML events buffer
+    double sf_events_clock_;  //!< MidiPortIn clock time sf_events_ were
+                                                                   //!< polled
+    bool simulation_thread_;  //!< Determines if the game is ticked on its own
+                            //!< thread, while the window thread draws snapshots
+    SnapshotBuffer snapshots_;  //!< Hands snapshots to the window thread
+    std::size_t song_index_;  //!< Index of current song in the playlist
+    int song_time_;  //!< Time in milliseconds since the current song started
+    std::future<bool> sound_font_;  //!< Background SoundFont load. Declared
+                             //!< after midi_out_, so it is destroyed first
+    int spawned_;  //!< Number of GameObjects spawned this tick
+    int spawned_counter_;  //!< Profiler counter ID for spawned GameObjects
+    sf::Clock startup_clock_;  //!< Measures time since the Game was created
+    std::uint64_t state_digest_;  //!< Hash of per-tick game state
+    double tick_clock_;  //!< MidiPortIn clock time this tick started
+    int ticks_;  //!< Number of ticks so far
+    int time_;  //!< Simulation time in milliseconds
+    TimerWheel timers_;  //!< Calls functions when their deadlines are due
+    int timers_counter_;  //!< Profiler counter ID for pending timers
+    TweenSystem tweens_;  //!< Animates GameObject properties
+    int tweens_counter_;  //!< Profiler counter ID for running tweens
+    int updates_counter_;  //!< Profiler counter ID for Component updates
     sf::RenderWindow window_;  //!< SFML window instance
+    std::vector<sf::Event> window_events_;  //!< SFML events polled by the
+                                       //!< window thread, waiting to be ticked
 };
 
 }   // End namespace midistar
@@ -0,0 +1,105 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDISTAR_GAMEMODES_H_
+#define MIDISTAR_GAMEMODES_H_
+
+#include <string>
+
+#include "midistar/DefaultGameObjectFactory.h"
+#include "midistar/DrumGameObjectFactory.h"
+#include "midistar/GameObjectFactory.h"
+#include "midistar/MidiFileIn.h"
+#include "midistar/PianoGameObjectFactory.h"
+
+namespace midistar {
+
+/**
+ * The GameModes class template selects a game mode by name from a list of
+ * GameObjectFactory types, which is fixed at compile time.
+ *
+ * Each factory type provides its mode name as MODE_NAME, and a static
+ * Create() function that builds the factory for a song. The last factory in
+ * the list is used if no mode name matches.
+ *
+ * \tparam Factories The GameObjectFactory types of each game mode.
+ */
+template <typename... Factories>
+class GameModes;
+
+/**
+ * Selects the last game mode in the list.
+ *
+ * \tparam Last The GameObjectFactory type of the last game mode.
+ */
+template <typename Last>
+class GameModes<Last> {
+ public:
+    /**
+     * Creates the GameObjectFactory for a game mode.
+     *
+     * \param name The game mode name.
+     * \param note_speed Used to calculate the falling speed of notes.
+     * \param file The MIDI file of the song.
+     *
+     * \return The new GameObjectFactory.
+     */
+    static GameObjectFactory* Create(const std::string& name, double
+            note_speed, const MidiFileIn& file);
+
+    /**
+     * Determines whether or not a name belongs to a game mode in the list.
+     *
+     * \param name The game mode name.
+     *
+     * \return True if the name matches a game mode. False otherwise.
+     */
+    static bool IsGameMode(const std::string& name);
+};
+
+/**
+ * Selects a game mode from a list of two or more.
+ *
+ * \tparam First The GameObjectFactory type of the first game mode.
+ * \tparam Rest The GameObjectFactory types of the other game modes.
+ */
+template <typename First, typename Second, typename... Rest>
+class GameModes<First, Second, Rest...> {
+ public:
+    /**
+     * \copydoc GameModes<Last>::Create()
+     */
+    static GameObjectFactory* Create(const std::string& name, double
+            note_speed, const MidiFileIn& file);
+
+    /**
+     * \copydoc GameModes<Last>::IsGameMode()
+     */
+    static bool IsGameMode(const std::string& name);
+};
+
+typedef GameModes<DrumGameObjectFactory, PianoGameObjectFactory
+    , DefaultGameObjectFactory> AllGameModes;  //!< Every game mode. Unknown
+                                           //!< names use the default game mode
+
+}  // End namespace midistar
+
+#include "GameModes.tpp"
+
+#endif  // MIDISTAR_GAMEMODES_H_
@@ -0,0 +1,53 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDISTAR_GAMEMODES_TPP_
+#define MIDISTAR_GAMEMODES_TPP_
+
+namespace midistar {
+
+template <typename Last>
+GameObjectFactory* GameModes<Last>::Create(const std::string&, double
+        note_speed, const MidiFileIn& file) {
+    return Last::Create(note_speed, file);
+}
+
+template <typename Last>
+bool GameModes<Last>::IsGameMode(const std::string& name) {
+    return name == Last::MODE_NAME;
+}
+
+template <typename First, typename Second, typename... Rest>
+GameObjectFactory* GameModes<First, Second, Rest...>::Create(const
+        std::string& name, double note_speed, const MidiFileIn& file) {
+    if (name == First::MODE_NAME) {
+        return First::Create(note_speed, file);
+    }
+    return GameModes<Second, Rest...>::Create(name, note_speed, file);
+}
+
+template <typename First, typename Second, typename... Rest>
+bool GameModes<First, Second, Rest...>::IsGameMode(const std::string& name) {
+    return name == First::MODE_NAME || GameModes<Second, Rest...>::IsGameMode(
+            name);
+}
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_GAMEMODES_TPP_
@@ -19,6 +19,7 @@
 #ifndef MIDISTAR_GAMEOBJECT_H_
 #define MIDISTAR_GAMEOBJECT_H_
 
+#include <cstdint>
 #include <vector>
 #include <SFML/Graphics.hpp>
 
@@ -35,6 +36,11 @@ class Game;
  * A GameObject may own one Component of each ComponentType at any given time.
  * Components are added or removed dynamically, which changes the GameObject's
  * behaviour during runtime.
+ *
+ * Only Components with behaviour are updated (see Component::IsUpdated()). A
+ * Component can also be put to sleep while it has nothing to do, and woken by
+ * whatever it is waiting on (such as a TimerWheel timer). A GameObject with
+ * no awake Components costs almost nothing to update.
  */
 class GameObject {
  public:
@@ -84,9 +90,9 @@ class GameObject {
     /**
      * Draws the GameObject.
      *
-     * \param[in] window The window to draw the GameObject in.
+     * \param[in] target The window or texture to draw the GameObject in.
      */
-    void Draw(sf::RenderWindow* window);
+    void Draw(sf::RenderTarget* target);
 
     /**
      * Gets the Component with the specified ComponentType.
@@ -153,6 +159,17 @@ class GameObject {
      */
     void SetComponent(Component* c);
 
+    /**
+     * Sets the per-ComponentType counts that the GameObject keeps up to date.
+     * The GameObject's current Components are moved from the previous counts
+     * (if any) to the new counts, and any Components added or removed
+     * afterwards are reflected in them.
+     *
+     * \param[in] counts Array of Component::NUM_COMPONENTS counts, or nullptr
+     * to stop counting.
+     */
+    void SetComponentCounts(int* counts);
+
     /**
      * Sets the position of the GameObject.
      *
@@ -178,15 +195,52 @@ class GameObject {
     void SetSize(double w, double h);
 
     /**
-     * Updates the GameObject by updating each of its Components.
+     * Stops updating the Component with the specified ComponentType until it
+     * is woken (see Wake()). Components are woken when they are replaced.
+     *
+     * \param type The ComponentType of the Component to put to sleep.
+     */
+    void Sleep(ComponentType type);
+
+    /**
+     * Updates the GameObject by updating each of its awake Components.
+     *
+     * \param g A reference to the current Game instance.
+     * \param delta The time in milliseconds since the end of last tick.
+     *
+     * \return The number of Components updated.
+     */
+    int Update(Game* g, int delta);
+
+    /**
+     * Updates only some of the GameObject's awake Components.
      *
      * \param g A reference to the current Game instance.
      * \param delta The time in milliseconds since the end of last tick.
+     * \param types Bit per ComponentType of the Components to update.
+     *
+     * \return The number of Components updated.
      */
-    void Update(Game* g, int delta);
+    int Update(Game* g, int delta, std::uint32_t types);
+
+    /**
+     * Starts updating a Component that was put to sleep (see Sleep()).
+     *
+     * \param type The ComponentType of the Component to wake.
+     */
+    void Wake(ComponentType type);
 
  private:
+    int NextAwakeComponent(int type, std::uint32_t types);  //!< Gets the
+                   //!< first awake ComponentType in types from type onwards,
+                   //!< or NUM_COMPONENTS if there is none
+
+    std::uint32_t awake_mask_;  //!< Bit per ComponentType of Components that
+                                          //!< have behaviour and are awake
     Component* components_[Component::NUM_COMPONENTS];  //!< Holds components
+    int* component_counts_;  //!< Live Component counts, indexed by type
+    std::uint32_t component_mask_;  //!< Bit per ComponentType of Components
+                                                        //!< the GameObject has
     sf::Drawable* drawable_;  //!< Holds drawable part of object
     double original_height_;  //!< Height at creation
     double original_width_;  //!< Width at creation
@@ -28,7 +28,10 @@ GameObject::GameObject(
     , double y_pos
     , double width
     , double height)
-        : components_{0}
+        : awake_mask_{0}
+        , components_{0}
+        , component_counts_{nullptr}
+        , component_mask_{0}
         , drawable_{drawformable}
         , original_height_{height}
         , original_width_{width}
@@ -22,7 +22,9 @@
 #include <vector>
 #include <SFML/Graphics.hpp>
 
+#include "midistar/EffectSystem.h"
 #include "midistar/GameObject.h"
+#include "midistar/TweenSystem.h"
 
 namespace midistar {
 
@@ -46,13 +48,28 @@ class GameObjectFactory {
     virtual ~GameObjectFactory() = default;
 
     /**
-     * Creates a grinding effect to indicate a note is being played.
+     * Animates a note play effect once it has been added, for example by
+     * fading it out. Does nothing by default.
+     *
+     * \param tweens The TweenSystem to animate the effect with.
+     * \param effects The EffectSystem holding the effect.
+     * \param effect The effect ID.
+     */
+    virtual void AnimateNotePlayEffect(TweenSystem* tweens, EffectSystem*
+            effects, int effect);
+
+    /**
+     * Creates a grinding effect to indicate a note is being played. The
+     * effect uses frames from the effect atlas (see GetEffectAtlas()).
      *
      * \param o The GameObject to use to create the effect.
+     * \param[out] effect Stores the note play effect.
      *
-     * \return A GameObject that represents a note play effect.
+     * \return True if an effect was created. False if the factory has no
+     * note play effect.
      */
-    virtual GameObject* CreateNotePlayEffect(GameObject* o) = 0;
+    virtual bool CreateNotePlayEffect(GameObject* o, EffectSystem::Effect*
+            effect) = 0;
 
     /**
      * Creates the instrument to play.
@@ -86,6 +103,32 @@ class GameObjectFactory {
      */
     const sf::Color& GetBackgroundColour();
 
+    /**
+     * Gets the texture atlas holding the frames of every effect created by
+     * the GameObjectFactory.
+     *
+     * \return Effect atlas.
+     */
+    const sf::Image& GetEffectAtlas();
+
+    /**
+     * Gets the width and height of each frame in the effect atlas.
+     *
+     * \return Frame size.
+     */
+    int GetEffectFrameSize();
+
+    /**
+     * Determines whether or not another GameObjectFactory creates the same
+     * instrument as this one. If so, the instrument created by one can be
+     * used with song notes created by the other.
+     *
+     * \param other The GameObjectFactory to compare with.
+     *
+     * \return True if the instruments are the same. False otherwise.
+     */
+    virtual bool HasSameLayout(const GameObjectFactory& other) const;
+
     /**
      * Initialises the GameObjectFactory.
      *
@@ -95,9 +138,13 @@ class GameObjectFactory {
 
  protected:
     double GetNoteSpeed();  //!< Gets note speed
+    void SetEffectAtlas(const sf::Image& atlas, int frame_size);  //!< Sets
+                                                   //!< the effect texture atlas
 
  private:
     const sf::Color background_colour_;  //!< Holds background colour
+    sf::Image effect_atlas_;  //!< Holds effect animation frames
+    int effect_frame_size_;  //!< Size of each effect atlas frame
     double note_speed_;  //!< Holds note speed
 };
 
@@ -0,0 +1,90 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIDISTAR_HITJUDGE_H_
+#define MIDISTAR_HITJUDGE_H_
+
+#include <ostream>
+
+namespace midistar {
+
+/**
+ * The HitJudge class judges how early or late song notes are played, and
+ * keeps a histogram of timing errors for the session.
+ *
+ * A hit is judged by comparing the time the instrument was pressed, taken
+ * from the input's arrival time, with the time the note was due, taken from
+ * the song. Neither depends on when the game ticked or drew a frame, so
+ * judgements stay accurate to the millisecond however low the frame rate is.
+ */
+class HitJudge {
+ public:
+    /**
+     * Constructor.
+     */
+    HitJudge();
+
+    /**
+     * Judges a hit.
+     *
+     * \param offset The time the instrument was pressed minus the time the
+     * note was due, in milliseconds. Negative offsets are early and positive
+     * offsets are late.
+     */
+    void AddHit(double offset);
+
+    /**
+     * Gets the number of hits judged.
+     *
+     * \return Number of hits.
+     */
+    int GetNumHits() const;
+
+    /**
+     * Discards all judged hits.
+     */
+    void Reset();
+
+    /**
+     * Writes the mean timing error and the timing error histogram.
+     *
+     * \param[out] out The stream to write to.
+     */
+    void WriteReport(std::ostream* out) const;
+
+ private:
+    static const int BUCKET_WIDTH = 5;  //!< Width of each histogram bucket in
+                                                             //!< milliseconds
+    static const int MAX_BAR_LENGTH = 50;  //!< Length of the longest bar in
+                                                              //!< the report
+    static const int NUM_BUCKETS = 40;  //!< Number of histogram buckets. Hits
+                     //!< outside the buckets are counted as too early or late
+    static const int WINDOW = BUCKET_WIDTH * NUM_BUCKETS / 2;  //!< Largest
+                                //!< offset in the histogram, in milliseconds
+
+    int buckets_[NUM_BUCKETS];  //!< Number of hits in each bucket
+    int num_hits_;  //!< Number of hits judged
+    double total_;  //!< Sum of offsets
+    double total_abs_;  //!< Sum of absolute offsets
+    int too_early_;  //!< Number of hits earlier than the histogram
+    int too_late_;  //!< Number of hits later than the histogram
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_HITJUDGE_H_
@@ -0,0 +1,133 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIDISTAR_INPUTLOG_H_
+#define MIDISTAR_INPUTLOG_H_
+
+#include <string>
+#include <vector>
+#include <SFML/Window.hpp>
+
+#include "midistar/MidiMessage.h"
+
+namespace midistar {
+
+/**
+ * The InputLog class records the input that reaches the Game, so that a
+ * played session can be replayed deterministically.
+ *
+ * The log holds the time difference of every tick, and every SFML event and
+ * MIDI message with the index of the tick in which it reached the Game.
+ * Replaying the log feeds the same input to the Game on the same ticks,
+ * independent of real time. Ticks can be 0ms long, so input is matched to
+ * ticks by index rather than by simulation time.
+ */
+class InputLog {
+ public:
+    /**
+     * Constructor.
+     */
+    InputLog();
+
+    /**
+     * Records a MIDI message.
+     *
+     * \param tick Index of the tick, counting from 0.
+     * \param msg The MIDI message.
+     */
+    void AddMidiMessage(int tick, const MidiMessage& msg);
+
+    /**
+     * Records an SFML event.
+     *
+     * \param tick Index of the tick, counting from 0.
+     * \param event The SFML event.
+     */
+    void AddSfEvent(int tick, const sf::Event& event);
+
+    /**
+     * Records the start of a tick.
+     *
+     * \param delta The time difference of the tick in milliseconds.
+     */
+    void AddTick(int delta);
+
+    /**
+     * Gets the input recorded in or before the given tick that has not been
+     * replayed yet.
+     *
+     * \param tick Index of the tick, counting from 0.
+     * \param[out] events Stores SFML events.
+     * \param[out] messages Stores MIDI messages.
+     */
+    void GetInput(
+            int tick
+            , std::vector<sf::Event>* events
+            , std::vector<MidiMessage>* messages);
+
+    /**
+     * Gets the time difference of the next recorded tick.
+     *
+     * \param[out] delta Stores the time difference in milliseconds.
+     *
+     * \return True for success. False if there are no more recorded ticks.
+     */
+    bool GetNextTick(int* delta);
+
+    /**
+     * Reads a log from disk.
+     *
+     * \param file_name The path of the log.
+     *
+     * \return true for success. false for failure.
+     */
+    bool Load(const std::string& file_name);
+
+    /**
+     * Writes the log to disk.
+     *
+     * \param file_name The path of the log.
+     *
+     * \return true for success. false for failure.
+     */
+    bool Save(const std::string& file_name) const;
+
+ private:
+    static constexpr const char* HEADER = "midistar_input_log 2";  //!< Holds
+                                                      //!< the log file header
+
+    /**
+     * Holds a recorded SFML event or MIDI message.
+     */
+    struct Entry {
+        int tick;  //!< Index of the tick the input reached the Game in
+        bool is_midi;  //!< True for a MIDI message. False for an SFML event
+        sf::Event event;  //!< Holds the SFML event
+        std::vector<unsigned char> data;  //!< Holds MIDI message data
+        double stamp;  //!< Holds MIDI message timestamp
+    };
+
+    std::vector<Entry> entries_;  //!< Recorded input, in tick order
+    unsigned entry_index_;  //!< Index of the next entry to replay
+    std::vector<int> ticks_;  //!< Recorded tick time differences
+    unsigned tick_index_;  //!< Index of the next tick to replay
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_INPUTLOG_H_
@@ -19,8 +19,6 @@
 #ifndef MIDISTAR_INSTRUMENTAUTOPLAYCOMPONENT_H_
 #define MIDISTAR_INSTRUMENTAUTOPLAYCOMPONENT_H_
 
-#include <vector>
-
 #include "midistar/CollisionHandlerComponent.h"
 
 namespace midistar {
@@ -60,7 +58,7 @@ class InstrumentAutoPlayComponent : public CollisionHandlerComponent {
              Game* g
              , GameObject* o
              , int delta
-             , std::vector<GameObject*> colliding_with);
+             , const VerticalCollisionDetectorComponent& contacts);
 
  private:
     static constexpr double DEFAULT_CENTRE_THRESHOLD = 10.0;  //!< Determines
@@ -33,11 +33,6 @@ class InstrumentComponent : public Component {
      * Constructor.
      */
     InstrumentComponent();
-
-    /**
-     * \copydoc Component::Update()
-     */
-    virtual void Update(Game* g, GameObject* o, int delta);
 };
 
 }   // End namespace midistar
@@ -30,14 +30,17 @@ namespace midistar {
  *
  * More specifically, it polls keyboard and MIDI input port events and
  * activates the instrument when applicable. While active, the instrument
- * plays a MIDI note and interacts with falling song notes on the screen.
+ * plays a MIDI note and interacts with falling song notes on the screen. If
+ * MIDI input port notes are played thru (see Game::IsMidiThru()), they have
+ * already sounded, so only notes played in other ways are sounded here.
  */
 class InstrumentInputHandlerComponent : public Component {
  public:
      /**
       * Constructor.
       *
-      * \param key The keyboard key to bind this instrument to.
+      * \param key The keyboard key to bind this instrument to, or
+      * sf::Keyboard::Unknown for no key binding.
       * \param ctrl Indicates whether or not the control key must be pressed
       * in conjunction with the key binding.
       * \param shift Indicates whether or not the shift key must be pressed
@@ -72,6 +75,17 @@ class InstrumentInputHandlerComponent : public Component {
       */
      void SetNotePlayed(bool note_played);
 
+     /**
+      * Gets the time a player last pressed the instrument, and forgets it so
+      * that each press is only taken once. The time is when the key press or
+      * MIDI note on arrived (see Game::GetInputTime()).
+      *
+      * \param[out] time Simulation time of the press in milliseconds.
+      *
+      * \return True if there was a press to take. False otherwise.
+      */
+     bool TakePressTime(double* time);
+
      /**
       * \copydoc Component::Update()
       */
@@ -81,17 +95,22 @@ class InstrumentInputHandlerComponent : public Component {
  private:
      static const int MAXIMUM_UNINVERT_DELAY = 100;  //!< Maximum time to delay
                                        //!< before uninverting instrument colour
+     int activated_time_;  //!< TimerWheel time the instrument was activated
      const bool ctrl_;  //!< Determines if the 'control' modifier has to be
                                   //!< pressed in conjunction with key binding
+     bool has_press_time_;  //!< Determines if press_time_ is yet to be taken
      const sf::Keyboard::Key key_;  //!< The key bound to this instrument
-     bool key_down_;  //!< Determines if the instrument is currently activated
+     bool key_down_;  //!< Determines if the bound key is held down
+     bool midi_down_;  //!< Determines if the MIDI input port note is held down
      bool note_played_;  //!< Indicates if a note has been played within the
                                                                   //!< last tick
+     double press_time_;  //!< Simulation time a player last pressed this
+                                                               //!< instrument
      bool set_active_;  //!< Determines if the instrument has been activated
                                                                 //!< externally
      const bool shift_;  //!< Determines if the 'shift' modifier has to be
                                   //!< pressed in conjunction with key binding
-     int uninvert_delay_;  //!< Time to delay before uninverting
+     bool sounding_;  //!< Determines if this instrument is playing a MIDI note
      bool was_active_;  //!< Determines if the instrument was active last tick
 };
 
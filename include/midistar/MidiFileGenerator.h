@@ -0,0 +1,105 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIDISTAR_MIDIFILEGENERATOR_H_
+#define MIDISTAR_MIDIFILEGENERATOR_H_
+
+#include <midifile/MidiFile.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace midistar {
+
+/**
+ * The MidiFileGenerator class writes synthetic MIDI files with controlled
+ * parameters. Generated files provide repeatable workloads for performance
+ * testing.
+ *
+ * Generation is deterministic: the same Parameters always produce the same
+ * file.
+ */
+class MidiFileGenerator {
+ public:
+    /**
+     * Describes the file to generate.
+     */
+    struct Parameters {
+        int chord_width;  //!< Number of notes started at the same time
+        int highest_key;  //!< Highest MIDI key to generate
+        double length;  //!< Length of the song in seconds
+        int lowest_key;  //!< Lowest MIDI key to generate
+        double max_note_length;  //!< Maximum note length in seconds
+        double min_note_length;  //!< Minimum note length in seconds
+        std::string note_length_distribution;  //!< One of "fixed", "uniform"
+                                                          //!< or "exponential"
+        double notes_per_second;  //!< Number of notes started per second
+        int num_tempo_changes;  //!< Number of tempo changes in the song
+        int num_tracks;  //!< Number of note tracks
+        bool percussion;  //!< Writes notes to the percussion channel
+        unsigned seed;  //!< Random seed
+    };
+
+    /**
+     * Constructor.
+     *
+     * \param params Describes the file to generate.
+     */
+    explicit MidiFileGenerator(const Parameters& params);
+
+    /**
+     * Generates the MIDI file and writes it to disk.
+     *
+     * \param file_name The path to write to.
+     *
+     * \return true for success. false for failure.
+     */
+    bool Write(const std::string& file_name);
+
+ private:
+    static const int NUM_MELODIC_CHANNELS = 15;  //!< Non-percussion channels
+    static const int PERCUSSION_CHANNEL = 9;  //!< General MIDI drum channel
+    static constexpr double DEFAULT_TEMPO = 120.0;  //!< Tempo in BPM when
+                                                    //!< there are no changes
+    static constexpr double MAX_TEMPO = 240.0;  //!< Max generated tempo
+    static constexpr double MIN_TEMPO = 60.0;  //!< Min generated tempo
+    static const int TICKS_PER_QUARTER_NOTE = 480;  //!< File resolution
+
+    /**
+     * A section of the song with a constant tempo.
+     */
+    struct TempoSegment {
+        double start_seconds;  //!< Time the segment starts
+        int start_tick;  //!< Tick the segment starts
+        double tempo;  //!< Tempo in BPM
+    };
+
+    void BuildTempoMap();  //!< Creates tempo segments
+    double NextNoteLength();  //!< Draws a note length from the distribution
+    int SecondsToTick(double seconds) const;  //!< Converts song time to ticks
+                                                       //!< using the tempo map
+
+    smf::MidiFile file_;  //!< The file being generated
+    Parameters params_;  //!< Describes the file to generate
+    std::mt19937 random_;  //!< Random number generator
+    std::vector<TempoSegment> tempo_map_;  //!< Tempo segments in time order
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_MIDIFILEGENERATOR_H_
@@ -22,17 +22,26 @@
 #include <midifile/MidiFile.h>
 #include <string>
 #include <vector>
-#include <SFML/System.hpp>
-
-#include "midistar/MidiIn.h"
 
 namespace midistar {
 
 /**
- * The MidiFileIn reads events from a MIDI file in a real-time fashion.
+ * The MidiFileIn class reads a MIDI file and schedules the song notes in it.
  */
-class MidiFileIn : public MidiIn {
+class MidiFileIn {
  public:
+    /**
+     * A song note in the note schedule.
+     */
+    struct ScheduledNote {
+        int channel;  //!< MIDI channel
+        double duration;  //!< Duration in seconds
+        int key;  //!< MIDI key, which determines the note's lane
+        double time;  //!< Time in milliseconds the note spawns
+        int track;  //!< MIDI track
+        int velocity;  //!< MIDI velocity
+    };
+
     /**
      * Constructor.
      */
@@ -49,6 +58,14 @@ class MidiFileIn : public MidiIn {
      */
     double GetMaximumNoteDuration() const;
 
+    /**
+     * Gets every song note in the MIDI file, in the order they spawn. Only
+     * notes on the configured tracks and channels are included.
+     *
+     * \return Note schedule.
+     */
+    const std::vector<ScheduledNote>& GetNoteSchedule() const;
+
     /**
      * Gets the ticks per quarter note of the MIDI file.
      *
@@ -72,20 +89,6 @@ class MidiFileIn : public MidiIn {
      */
     bool Init(const std::string& file_name);
 
-    /**
-     * Determines whether or not the reader is at the end of the MIDI file.
-     *
-     * \return True if the reader is at EOF. False otherwise.
-     */
-    bool IsEof();
-
-    /**
-     * Advances the reader by the time difference specified.
-     *
-     * \param delta The time difference to advance the reader by.
-     */
-    void Tick(int delta);
-
  private:
     static const int MAX_MIDI_CHANNELS = 16;
     static const int MAX_MIDI_TRACKS = 128;
@@ -96,8 +99,7 @@ class MidiFileIn : public MidiIn {
     bool channels_[MAX_MIDI_CHANNELS];  //!< The channels to read from. Each
             //!< index represents a channel. Only read from channels with true.
     smf::MidiFile file_;  //!< Underlying MIDI file instance
-    int index_;  //!< Index of event in track
-    int time_;  //!< The time index of the reade
+    std::vector<ScheduledNote> schedule_;  //!< Holds the note schedule
     bool tracks_[MAX_MIDI_TRACKS];  //!< The tracks to read from. Each index
                       //!< represents a track. Only read from tracks with true.
 };
@@ -30,6 +30,11 @@ namespace midistar {
  */
 class MidiIn {
  public:
+    /**
+     * Destructor.
+     */
+    virtual ~MidiIn() = default;
+
     /**
      * Gets the next MIDI message.
      *
@@ -0,0 +1,124 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDISTAR_MIDIINPUTFILTER_H_
+#define MIDISTAR_MIDIINPUTFILTER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace midistar {
+
+/**
+ * The MidiInputFilter class decides which messages from a MIDI input port
+ * reach the game, by message type and by channel.
+ *
+ * Messages are filtered as soon as they are read from RtMidi, before they are
+ * turned into MidiMessages, so ignored messages (such as MIDI clock, active
+ * sensing and SysEx) cost the game almost nothing. The number of messages
+ * dropped and passed are counted. Counting is safe from any thread.
+ */
+class MidiInputFilter {
+ public:
+    /**
+     * Kinds of MIDI messages that can be filtered.
+     */
+    enum MessageType {
+        ACTIVE_SENSING,
+        CHANNEL_AFTERTOUCH,
+        CONTROL_CHANGE,
+        NOTE_OFF,
+        NOTE_ON,
+        PITCH_BEND,
+        POLY_AFTERTOUCH,
+        PROGRAM_CHANGE,
+        SYSEX,
+        SYSTEM,
+        TIMING,
+        NUM_MESSAGE_TYPES  // Must be last
+    };
+
+    /**
+     * Constructor. Until it is initialised, the filter passes everything.
+     */
+    MidiInputFilter();
+
+    /**
+     * Determines whether or not a message is passed, and counts it.
+     *
+     * \param data The raw MIDI message.
+     *
+     * \return True if the message is passed. False if it is dropped.
+     */
+    bool Accept(const std::vector<unsigned char>& data);
+
+    /**
+     * Gets the number of messages dropped so far.
+     *
+     * \return Number of dropped messages.
+     */
+    std::uint64_t GetDropped() const;
+
+    /**
+     * Gets the number of messages passed so far.
+     *
+     * \return Number of passed messages.
+     */
+    std::uint64_t GetPassed() const;
+
+    /**
+     * Initialises the filter.
+     *
+     * \param ignored_types Names of the message types to drop: "note_off",
+     * "note_on", "poly_aftertouch", "control_change", "program_change",
+     * "channel_aftertouch", "pitch_bend", "sysex", "timing" (MIDI clock,
+     * start, stop, continue and time code), "active_sensing" and "system"
+     * (any other system message).
+     * \param channels The channels (0 to 15) to pass channel messages from. -1
+     * passes every channel. System messages have no channel.
+     *
+     * \return true for success. false if a message type is unknown.
+     */
+    bool Init(const std::vector<std::string>& ignored_types, const
+            std::vector<int>& channels);
+
+ private:
+    static const int ALL_CHANNELS = 0xffff;  //!< Channel mask of all channels
+    static const unsigned char CHANNEL_MASK = 0x0f;  //!< Mask for channel
+    static const unsigned char COMMAND_MASK = 0xf0;  //!< Mask for command
+    static const int NUM_CHANNELS = 16;  //!< Number of MIDI channels
+    static const unsigned char SYSTEM_COMMAND = 0xf0;  //!< Command of system
+                                          //!< messages, which have no channel
+    static const char* const TYPE_NAMES[NUM_MESSAGE_TYPES];  //!< Names of
+                                         //!< message types, indexed by type
+
+    static MessageType GetType(unsigned char status);  //!< Gets the type of
+                                              //!< message from its status byte
+
+    std::uint32_t channel_mask_;  //!< Bit per channel that is passed
+    std::atomic<std::uint64_t> dropped_;  //!< Number of dropped messages
+    std::atomic<std::uint64_t> passed_;  //!< Number of passed messages
+    std::uint32_t type_mask_;  //!< Bit per MessageType that is passed
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_MIDIINPUTFILTER_H_
@@ -19,20 +19,64 @@
 #ifndef MIDISTAR_MIDIINSTRUMENTIN_H_
 #define MIDISTAR_MIDIINSTRUMENTIN_H_
 
+#include <atomic>
+
 #include "midistar/MidiMessage.h"
+#include "midistar/MidiOut.h"
 #include "midistar/MidiPortIn.h"
 
 namespace midistar {
 
 /**
- * The MidiIn class provides an interface for MIDI stream readers.
+ * The MidiInstrumentIn class reads notes played on a MIDI instrument, remapped
+ * as configured (see Config::GetInstrumentMidiNoteRemapping()).
+ *
+ * Notes can also be played thru to a MidiOut as soon as they arrive, so they
+ * sound without waiting for the game to tick.
  */
 class MidiInstrumentIn : public MidiPortIn {
  public:
+    /**
+     * Constructor.
+     */
+    MidiInstrumentIn();
+
+    /**
+     * Destructor. Closes the ports before thru notes can no longer be played.
+     */
+    virtual ~MidiInstrumentIn();
+
     /**
      * \copydoc MidiIn::GetMessage(MidiMessage*)
      */
     virtual bool GetMessage(MidiMessage* message);
+
+    /**
+     * Plays notes on a MidiOut as soon as they arrive, on the RtMidi callback
+     * thread of their port. Notes are remapped and played on the thru channel,
+     * at the velocity the game plays notes at. Must be called before Init().
+     *
+     * \param out The MidiOut to play notes on. It must outlive this object.
+     */
+    void SetThru(MidiOut* out);
+
+    /**
+     * Sets the MIDI channel thru notes are played on. This is safe to call
+     * while notes are arriving.
+     *
+     * \param chan MIDI channel.
+     */
+    void SetThruChannel(int chan);
+
+ protected:
+    /**
+     * \copydoc MidiPortIn::OnReceive()
+     */
+    virtual void OnReceive(const MidiMessage& message);
+
+ private:
+    MidiOut* thru_;  //!< MidiOut notes are played thru to, if any
+    std::atomic<int> thru_channel_;  //!< MIDI channel of thru notes
 };
 
 }  // End namespace midistar
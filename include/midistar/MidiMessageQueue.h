@@ -0,0 +1,78 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIDISTAR_MIDIMESSAGEQUEUE_H_
+#define MIDISTAR_MIDIMESSAGEQUEUE_H_
+
+#include <atomic>
+
+#include "midistar/MidiMessage.h"
+
+namespace midistar {
+
+/**
+ * The MidiMessageQueue class hands MidiMessages from one producer thread to
+ * one consumer thread without either of them waiting on the other.
+ *
+ * Messages are held in a fixed-size ring. The producer only writes the tail
+ * index and the consumer only writes the head index, so each push and pop is
+ * a single atomic store. Messages pushed while the ring is full are dropped.
+ */
+class MidiMessageQueue {
+ public:
+    /**
+     * Constructor.
+     */
+    MidiMessageQueue();
+
+    /**
+     * Gets the oldest message without removing it. Only the consumer thread
+     * may call this.
+     *
+     * \param[out] message The oldest message, if there is one.
+     *
+     * \return True if there was a message. False if the queue is empty.
+     */
+    bool Peek(MidiMessage* message) const;
+
+    /**
+     * Removes the oldest message. Only the consumer thread may call this, and
+     * only after Peek() has returned true.
+     */
+    void Pop();
+
+    /**
+     * Adds a message. Only the producer thread may call this.
+     *
+     * \param message The message to add.
+     *
+     * \return True if the message was added. False if the queue was full.
+     */
+    bool Push(const MidiMessage& message);
+
+ private:
+    static const unsigned CAPACITY = 1024;  //!< Number of slots in the ring
+
+    std::atomic<unsigned> head_;  //!< Index of the oldest message
+    MidiMessage slots_[CAPACITY];  //!< Message storage
+    std::atomic<unsigned> tail_;  //!< Index one past the newest message
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_MIDIMESSAGEQUEUE_H_
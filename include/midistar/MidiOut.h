@@ -20,11 +20,16 @@
 #define MIDISTAR_MIDIOUT_H_
 
 #include <fluidsynth.h>
+#include <ostream>
+#include <string>
 
 namespace midistar {
 
 /**
  * The MidiOut class provides an interface for playing MIDI audio.
+ *
+ * Audio is either played in real time through an audio driver, or rendered
+ * to a WAV file on the simulation clock (see InitFileRenderer()).
  */
 class MidiOut {
  public:
@@ -39,12 +44,75 @@ class MidiOut {
     ~MidiOut();
 
     /**
-     * Initialises the class.
+     * Initialises the class. The SoundFont is loaded separately, with
+     * LoadSoundFont(), which may be called from another thread. Resident
+     * memory is sampled here, as the baseline reported by PinPresets().
      *
      * \return true for success. false indicates failure.
      */
     bool Init();
 
+    /**
+     * Initialises the class to render audio to a file instead of playing it.
+     * Audio is only rendered when Render() is called, so rendering is not
+     * tied to real time. Rendering is deterministic: the same notes at the
+     * same times always produce the same file. The SoundFont is loaded
+     * separately, with LoadSoundFont(). Resident memory is sampled here, as
+     * the baseline reported by PinPresets().
+     *
+     * \param file_name The WAV file to write.
+     *
+     * \return true for success. false indicates failure.
+     */
+    bool InitFileRenderer(const std::string& file_name);
+
+    /**
+     * Turns off all notes and renders until they have faded out. Only used
+     * when rendering to a file.
+     *
+     * \param time The simulation time in milliseconds.
+     *
+     * \return true for success. false indicates that rendering has failed,
+     *         now or on an earlier call to Render().
+     */
+    bool EndFileRender(int time);
+
+    /**
+     * Loads the configured SoundFont. Until it is loaded, notes are silent.
+     * This is safe to call from another thread while notes are being sent.
+     *
+     * Only preset headers are read up front. Sample data is loaded when a
+     * preset is first selected on a channel, or pinned with PinPresets().
+     *
+     * \return true for success. false indicates failure.
+     */
+    bool LoadSoundFont();
+
+    /**
+     * Pins the piano (bank 0 program 0) and drum kit (bank 128 program 0)
+     * presets, so their sample data is loaded now and stays loaded. Program
+     * changes are never sent, so these are the only presets played: every
+     * channel but the drum channel plays the piano preset. Pinning needs
+     * fluidsynth 2.2. Older versions load the presets when the SoundFont
+     * loads instead. Resident memory before any loading started (see Init())
+     * and after pinning is reported.
+     *
+     * \param[out] out The stream to report to.
+     */
+    void PinPresets(std::ostream* out);
+
+    /**
+     * Renders audio up to a point on the simulation clock. Notes sent
+     * afterwards start at that point, within fluidsynth's block size (64
+     * samples). Only used when rendering to a file.
+     *
+     * \param time The simulation time in milliseconds.
+     *
+     * \return true for success. false indicates that rendering has failed,
+     *         now or earlier. The file is left incomplete.
+     */
+    bool Render(int time);
+
     /**
      * Sends a MIDI note off event.
      *
@@ -63,7 +131,19 @@ class MidiOut {
     void SendNoteOn(int note, int chan, int velocity);
 
  private:
+    static const int BLOCK_SIZE = 64;  //!< Samples rendered per block
+    static const long long BYTES_PER_MB = 1024 * 1024;  //!< Bytes in a MB
+    static const int DRUM_BANK = 128;  //!< SoundFont bank of drum kits
+    static const int NUM_CHANNELS = 16;  //!< Number of MIDI channels
+    static const int RELEASE_TIME = 3000;  //!< Time in milliseconds rendered
+                                        //!< after a file render for release
+    static constexpr double SAMPLE_RATE = 44100.0;  //!< File sample rate
+
     fluid_audio_driver_t* a_driver_;  //!< Stores fluidsynth audio driver
+    fluid_file_renderer_t* file_renderer_;  //!< Stores file renderer
+    bool render_failed_;  //!< Whether rendering to file has failed
+    long long rendered_samples_;  //!< Number of samples rendered to file
+    long long resident_memory_;  //!< Resident memory before loading started
     int s_font_id_;  //!< Stores SoundFont handle
     fluid_settings_t* settings_;  //!< Stores fluidsynth settings
     fluid_synth_t* synth_;  //!< Stores fluidsynth synth instance
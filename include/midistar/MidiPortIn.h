@@ -21,15 +21,29 @@
 
 #include <rtmidi/RtMidi.h>
 
+#include <condition_variable>
+#include <mutex>
 #include <queue>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "midistar/MidiIn.h"
+#include "midistar/MidiInputFilter.h"
+#include "midistar/MidiMessageQueue.h"
 
 namespace midistar {
 
 /**
- * The MidiPortIn class provides an interface for reading from a MIDI input
- * port.
+ * The MidiPortIn class provides an interface for reading from MIDI input
+ * ports.
+ *
+ * Every configured port (see Config::GetMidiInPorts()) is opened, and each
+ * one feeds its own MidiMessageQueue from its RtMidi callback thread. Each
+ * tick, the queues are merged in order of message arrival time. Ports are
+ * looked for again on a background thread, so ports that are plugged in
+ * later are opened and ports that are unplugged are closed without holding
+ * up the game.
  */
 class MidiPortIn : public MidiIn {
  public:
@@ -48,23 +62,92 @@ class MidiPortIn : public MidiIn {
     MidiPortIn();
 
     /**
-     * Initialises class.
+     * Destructor. Stops looking for ports and closes them.
+     */
+    virtual ~MidiPortIn();
+
+    /**
+     * Stops looking for ports and closes them, so no more messages arrive.
+     * Classes that override OnReceive() must call this in their destructor,
+     * so it is never called on a partly destroyed object.
+     */
+    void Close();
+
+    /**
+     * Gets the current time on the clock that message times are measured
+     * with. Messages read from a port have the time they arrived at.
+     *
+     * \return Time in seconds.
+     */
+    static double GetClockTime();
+
+    /**
+     * Gets the filter that decides which messages are read from the ports.
+     *
+     * \return MidiInputFilter instance.
+     */
+    const MidiInputFilter& GetFilter() const;
+
+    /**
+     * Initialises class. The MidiInputFilter is set up as configured (see
+     * Config::GetMidiInIgnore() and Config::GetMidiInChannels()), the ports
+     * that are already plugged in are opened, and the background thread
+     * starts looking for ports.
      *
      * \return true for success. false indicates failure.
      */
     bool Init();
 
     /**
-     * Checks the MIDI port for events and reads them.
+     * Reads the messages that arrived at the ports since the last tick.
      */
     void Tick();
 
+ protected:
+    /**
+     * Handles a message as soon as it arrives, on the RtMidi callback thread
+     * of its port, before it is queued. Messages from different ports may be
+     * handled at the same time. Does nothing by default.
+     *
+     * \param message The message that arrived.
+     */
+    virtual void OnReceive(const MidiMessage& message);
+
  private:
-     bool extend_same_tick_notes_;  //!< Extends notes that start / finish in
-                                                              //!< the same tick
-     RtMidiIn* midi_in_;  //!< MIDI port instance
-     std::queue<MidiMessage> same_tick_buffer_;  //!< Holds note end events that
-                           //!< occured in the same tick as the note start
+    /**
+     * An open MIDI input port.
+     */
+    struct Port {
+        int index;  //!< Index of the port in Config::GetMidiInPorts()
+        double last_time;  //!< Arrival time of the last message, or -1
+        RtMidiIn* midi_in;  //!< MIDI port instance
+        std::string name;  //!< Port name
+        unsigned number;  //!< RtMidi port number
+        MidiPortIn* owner;  //!< MidiPortIn the port belongs to
+        MidiMessageQueue queue;  //!< Messages waiting to be read
+    };
+
+    static const int SCAN_INTERVAL = 1000;  //!< Time between looks for ports,
+                                                         //!< in milliseconds
+
+    static void OnRtMidiMessage(double stamp, std::vector<unsigned char>*
+            data, void* port);  //!< Receives messages on the RtMidi thread
+    void RunScanner();  //!< Background thread loop
+    void Scan();  //!< Opens plugged in ports and closes unplugged ones
+
+    bool extend_same_tick_notes_;  //!< Extends notes that start / finish in
+                                                             //!< the same tick
+    MidiInputFilter filter_;  //!< Drops unwanted messages as they arrive
+    std::vector<Port*> ports_;  //!< Open ports
+    std::mutex ports_mutex_;  //!< Guards ports_
+    RtMidiIn* probe_;  //!< Lists ports. Only used by Scan()
+    std::vector<MidiMessage> received_;  //!< Messages received this tick
+    std::queue<MidiMessage> same_tick_buffer_;  //!< Holds note end events that
+                          //!< occured in the same tick as the note start
+    std::thread scanner_;  //!< Background thread looking for ports
+    std::condition_variable scanner_changed_;  //!< Signals stopping_ changes
+    std::mutex scanner_mutex_;  //!< Guards stopping_
+    bool stopping_;  //!< Tells the background thread to exit
 };
 
 }  // End namespace midistar
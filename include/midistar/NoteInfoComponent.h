@@ -73,11 +73,6 @@ class NoteInfoComponent : public Component {
      */
     bool HasTrack();
 
-    /**
-     * \copydoc Component::Update()
-     */
-    void Update(Game* g, GameObject* o, int delta);
-
  private:
     int chan_;  //!< Holds MIDI channel
     int note_;  //!< Holds MIDI note
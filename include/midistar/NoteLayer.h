@@ -0,0 +1,125 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDISTAR_NOTELAYER_H_
+#define MIDISTAR_NOTELAYER_H_
+
+#include <cstddef>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "midistar/GameObjectFactory.h"
+#include "midistar/MidiFileIn.h"
+
+namespace midistar {
+
+/**
+ * The NoteLayer class draws the song notes of a MIDI file that have not yet
+ * reached the instrument.
+ *
+ * The geometry of every note in the song is built once, in song time
+ * coordinates, and uploaded to a static vertex buffer. Each frame, the whole
+ * layer is scrolled by a single transform for the song time, so drawing costs
+ * the same however many notes are falling. A note only becomes a GameObject
+ * once it reaches the activation line above the instrument, where it can be
+ * played, clipped and so on.
+ *
+ * The vertex buffer is only filled when the layer is drawn, so a layer can
+ * be built on a thread other than the drawing thread, and then handed over
+ * with Take().
+ */
+class NoteLayer {
+ public:
+    /**
+     * Constructor.
+     */
+    NoteLayer();
+
+    /**
+     * Removes all notes. The layer is inactive until it is initialised again.
+     */
+    void Clear();
+
+    /**
+     * Draws the notes that have not been activated in a single draw call. The
+     * vertex buffer is filled first if the notes have changed.
+     *
+     * \param[in] target The render target to draw to.
+     * \param first The schedule index of the first note that has not been
+     * activated.
+     * \param song_time The time in milliseconds since the song started.
+     */
+    void Draw(sf::RenderTarget* target, std::size_t first, double song_time);
+
+    /**
+     * Gets the song time at which a note reaches the activation line.
+     *
+     * \param index The schedule index of the note.
+     *
+     * \return Activation time in milliseconds.
+     */
+    double GetActivationTime(std::size_t index) const;
+
+    /**
+     * Builds the layer from a note schedule.
+     *
+     * Notes are created with the GameObjectFactory to find their shape and
+     * speed. The layer can only hold rectangular notes that fall at the same
+     * speed; otherwise, it is left inactive.
+     *
+     * \param schedule The note schedule of the song.
+     * \param factory The GameObjectFactory for the song.
+     * \param activation_y The Y position at which notes are activated.
+     *
+     * \return true if the layer holds the song. false if it can't.
+     */
+    bool Init(const std::vector<MidiFileIn::ScheduledNote>& schedule
+            , GameObjectFactory* factory, double activation_y);
+
+    /**
+     * Determines whether or not the layer holds a song.
+     *
+     * \return True if the layer is active. False otherwise.
+     */
+    bool IsActive() const;
+
+    /**
+     * Replaces the notes with those of another layer, which is left empty.
+     * Only the notes are moved. The vertex buffer stays with this layer, and
+     * is filled the next time it is drawn.
+     *
+     * \param other The layer to take the notes from.
+     */
+    void Take(NoteLayer* other);
+
+ private:
+    static const int VERTICES_PER_NOTE = 8;  //!< An outline and a fill quad
+
+    std::vector<double> activation_times_;  //!< Activation time of each note
+    bool active_;  //!< Determines if the layer holds a song
+    sf::VertexBuffer buffer_;  //!< Holds note geometry on the GPU
+    bool changed_;  //!< Determines if buffer_ is older than vertices_
+    double speed_;  //!< Fall speed of notes in pixels per millisecond
+    std::vector<sf::Vertex> vertices_;  //!< Note geometry in song time
+                  //!< coordinates, drawn if vertex buffers are not available
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_NOTELAYER_H_
@@ -0,0 +1,51 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDISTAR_OFFLINERENDERER_H_
+#define MIDISTAR_OFFLINERENDERER_H_
+
+namespace midistar {
+
+/**
+ * The OfflineRenderer class renders a game to a sequence of video frames
+ * and/or a WAV file.
+ *
+ * The Game is stepped on a fixed simulated clock at the configured frame
+ * rate, rather than in real time. Each frame is drawn to an off-screen
+ * texture and written with a FrameWriter, and audio is rendered by MidiOut on
+ * the same clock, so the two line up. Rendering runs as fast as the machine
+ * allows, so it is usually faster than real time, and no frames are dropped.
+ * Auto play or replayed input (see InputLog) provide the playing.
+ */
+class OfflineRenderer {
+ public:
+    /**
+     * Renders the configured MIDI file.
+     *
+     * \return true for success. false for failure.
+     */
+    bool Run();
+
+ private:
+    static const int MAX_FRAMES = 1000000;  //!< Stops runaway renders
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_OFFLINERENDERER_H_
@@ -28,7 +28,9 @@ namespace midistar {
  * The PhysicsComponent class provides velocity functionality to its owner.
  *
  * Each tick, the X and Y position of the owner are updated by the X velocity
- * and Y velocity respectively.
+ * and Y velocity respectively. Positions are calculated from the total time
+ * the owner has been moving, rather than added up tick by tick, so they do not
+ * drift. If something else moves the owner, it carries on from there.
  */
 class PhysicsComponent : public Component {
  public:
@@ -40,6 +42,15 @@ class PhysicsComponent : public Component {
      */
     PhysicsComponent(double x_vel, double y_vel);
 
+    /**
+     * Moves the owner to where it would be after moving for the given
+     * time.
+     *
+     * \param o The owner of the component.
+     * \param time The time in milliseconds to move for.
+     */
+    void Advance(GameObject* o, double time);
+
     /**
      * Gets the velocity.
      *
@@ -62,6 +73,12 @@ class PhysicsComponent : public Component {
     virtual void Update(Game* g, GameObject* o, int delta);
 
  private:
+    double elapsed_;  //!< Time in milliseconds spent moving
+    bool has_origin_;  //!< Determines if the origin has been set
+    double last_x_;  //!< X position the owner was last moved to
+    double last_y_;  //!< Y position the owner was last moved to
+    double origin_x_;  //!< X position before moving
+    double origin_y_;  //!< Y position before moving
     double x_vel_;  //!< Stores X velocity
     double y_vel_;  //!< Stores Y velocity
 };
@@ -24,6 +24,7 @@
 
 #include "midistar/GameObject.h"
 #include "midistar/GameObjectFactory.h"
+#include "midistar/MidiFileIn.h"
 
 namespace midistar {
 
@@ -33,6 +34,8 @@ namespace midistar {
  */
 class PianoGameObjectFactory : public GameObjectFactory {
  public:
+    static constexpr const char* MODE_NAME = "piano";  //!< Game mode name
+
    /**
     * Constructor
     *
@@ -40,10 +43,22 @@ class PianoGameObjectFactory : public GameObjectFactory {
     */
     explicit PianoGameObjectFactory(double note_speed);
 
+    /**
+     * Creates a PianoGameObjectFactory for a song (see GameModes).
+     *
+     * \param note_speed Used to calculate the falling speed of notes.
+     * \param file The MIDI file of the song.
+     *
+     * \return The new GameObjectFactory.
+     */
+    static GameObjectFactory* Create(double note_speed, const MidiFileIn&
+            file);
+
    /**
      * \copydoc GameObjectFactory::CreateNotePlayEffect()
      */
-    virtual GameObject* CreateNotePlayEffect(GameObject* o);
+    virtual bool CreateNotePlayEffect(GameObject* o, EffectSystem::Effect*
+            effect);
 
    /**
      * \copydoc GameObjectFactory::CreateInstrument()
@@ -77,14 +92,16 @@ class PianoGameObjectFactory : public GameObjectFactory {
     static constexpr float NOTE_OUTLINE_THICKNESS = -2.0f;  //!< Note outline
     static const char NOTES_PER_OCTAVE = 12;  //!< Notes in an octave
     static const char NUM_BLACK_KEYS = 36;  //!< Num black keys on a piano
+    static const int NUM_MIDI_KEYS = 128;  //!< Number of MIDI keys
     static const char NUM_PIANO_KEYS = 88;  //!< Total num keys on a piano
     static const char NUM_TRACK_COLOURS = 6;  //!< Number of track colours
     static const char NUM_WHITE_KEYS = NUM_PIANO_KEYS - NUM_BLACK_KEYS;
                                                 //!< Num white keys on a piano
-    static const bool OCTAVE_BLACK_KEYS[NOTES_PER_OCTAVE];  //!< Black key
-                                                      //!< lookup in an octave
-    static const char OCTAVE_KEY_TO_WHITE_KEY[NOTES_PER_OCTAVE];  //!< Converts
-                                      //!< a key index to the closest white key
+    static constexpr bool OCTAVE_BLACK_KEYS[NOTES_PER_OCTAVE] {0, 1, 0, 0, 1
+        , 0, 1, 0, 0, 1, 0, 1};  //!< Black key lookup in an octave
+    static constexpr char OCTAVE_KEY_TO_WHITE_KEY[NOTES_PER_OCTAVE] {0, 0, 1
+        , 2, 2, 3, 3, 4, 5, 5, 6, 6};  //!< Converts a key index to the closest
+                                                                //!< white key
     static const char PIANO_FIRST_MIDI_KEY = 21;  //!< First MIDI key on a
                                                                     //!< piano
     static const int WHITE_KEY_HEIGHT = 150;  //!< White key height
@@ -102,9 +119,24 @@ class PianoGameObjectFactory : public GameObjectFactory {
     static const sf::Color MIDI_TRACK_COLOURS[NUM_TRACK_COLOURS];  //!< Holds
                                                         //!< MIDI track colours
 
+    /**
+     * Holds the piano layout of every MIDI key.
+     */
+    struct KeyTable {
+        bool black[NUM_MIDI_KEYS];  //!< Determines if a key is a black key
+        int white_index[NUM_MIDI_KEYS];  //!< Index of the closest white key
+                                                          //!< at or below a key
+    };
+
+    static const KeyTable KEY_TABLE;  //!< Layout of every MIDI key, built at
+                                                              //!< compile time
+
+    static constexpr KeyTable MakeKeyTable();  //!< Builds KEY_TABLE
     static sf::Color GetTrackColour(int midi_track);  //!< Get colour for track
     static void GetInstrumentKeyBinding(int midi_key, sf::Keyboard::Key* key,
             bool* ctrl, bool* shift);  //!< Gets instrument key binding
+    static double GetInstrumentY();  //!< Gets the Y position of the top of
+                                                                 //!< the piano
     static int GetWhiteKeyIndex(int midi_key);  //!< Gets the index of the
                                     //!< closest white piano key to a MIDI key
     static bool IsBlackKey(int midi_key);  //!< Determines if a MIDI key
@@ -115,7 +147,7 @@ class PianoGameObjectFactory : public GameObjectFactory {
     GameObject* CreateInstrumentNote(int midi_key);  //!< Creates a note for
                                                                  //!< the piano
 
-    sf::Texture grinding_texture_;  //!< Holds texture to represent metal grind
+    int grinding_frames_;  //!< Number of frames in the grinding animation
     double white_width_;  //!< Holds the width of white keys and notes
 };
 
@@ -19,22 +19,55 @@
 #ifndef MIDISTAR_PIANOSONGNOTECOLLISIONHANDLERCOMPONENT_H_
 #define MIDISTAR_PIANOSONGNOTECOLLISIONHANDLERCOMPONENT_H_
 
-#include <vector>
-
 #include "midistar/CollisionHandlerComponent.h"
+#include "midistar/TimerWheel.h"
 
 namespace midistar {
 
 /**
  * The PianoSongNoteCollisionHandlerComponent class handles collisions between
  * song notes and other GameObjects.
+ *
+ * Each note moves through a state machine: it approaches the instrument,
+ * becomes playable once it reaches the top of the instrument, is played while
+ * the matching instrument key is held, and is missed once its top passes the
+ * playable part of the instrument. The times of these thresholds are worked
+ * out once, from the note's speed, so hit and miss decisions do not depend on
+ * the frame rate. The note's collision detection sleeps while the note is
+ * approaching, and once it has been missed or played.
  */
 class PianoSongNoteCollisionHandlerComponent : public CollisionHandlerComponent{
  public:
+     /**
+      * The states of a song note.
+      */
+     enum State {
+         APPROACHING  //!< Falling towards the instrument
+         , PLAYABLE  //!< Can be played, but isn't being played
+         , BEING_PLAYED  //!< Being played by the instrument
+         , MISSED  //!< Has passed the instrument without being played
+         , DONE  //!< Has been completely played
+     };
+
      /**
       * Constructor.
+      *
+      * \param instrument_y The Y position of the top of the instrument.
+      */
+     explicit PianoSongNoteCollisionHandlerComponent(double instrument_y);
+
+     /**
+      * Destructor. Removes the grinding effect, if the note is being played,
+      * and cancels the timer that wakes the note.
+      */
+     ~PianoSongNoteCollisionHandlerComponent();
+
+     /**
+      * Gets the current state of the note.
+      *
+      * \return Note state.
       */
-     PianoSongNoteCollisionHandlerComponent();
+     State GetState() const;
 
      /**
       * \copydoc CollisionHandlerComponent::HandleCollisions()
@@ -43,17 +76,37 @@ class PianoSongNoteCollisionHandlerComponent : public CollisionHandlerComponent{
              Game* g
              , GameObject* o
              , int delta
-             , std::vector<GameObject*> colliding_with);
+             , const VerticalCollisionDetectorComponent& contacts);
 
  private:
     static const char NOTE_COLLISION_CUTOFF = 20;  //!< Notes must be within
         //!< this many pixels from the top of the instrument to be completely
         //!< played.
 
-    bool HandleCollision(Game* g, GameObject* o, GameObject* collider);
-               //!< Handles a collision returns true if it's a valid collision
+    bool InitThresholds(Game* g, GameObject* o);  //!< Works out the state
+                          //!< threshold times. Returns false if o doesn't move
+    void SleepUntilPlayable(GameObject* o, double time);  //!< Puts collision
+                          //!< detection to sleep until the note is playable
+    void StartPlaying(Game* g, GameObject* o, GameObject* instrument);
+                                             //!< Moves to the BEING_PLAYED state
+    void StopPlaying();  //!< Moves out of the BEING_PLAYED state
+    void UpdateInstrument(GameObject* o, const
+            VerticalCollisionDetectorComponent& contacts);  //!< Tracks the
+                        //!< instrument playing the note from contact changes
 
-    GameObject* grinding_;  //!< Holds GameObject display metal grinding effect
+    Game* game_;  //!< Holds the Game showing grinding_
+    int grinding_;  //!< Holds ID of the metal grinding effect
+    bool has_thresholds_;  //!< Determines if threshold times are worked out
+    GameObject* instrument_;  //!< Instrument in contact that can play the
+                                                      //!< note, or nullptr if none
+    double instrument_y_;  //!< Y position of the top of the instrument
+    double missed_time_;  //!< Time the note's top passes the cutoff
+    double playable_time_;  //!< Time the note's bottom reaches the instrument
+    int start_time_;  //!< TimerWheel time of the first update
+    State state_;  //!< Current note state
+    TimerWheel* timers_;  //!< Holds the TimerWheel running wake_timer_
+    int wake_timer_;  //!< Holds ID of the timer that wakes the note when it
+                                                             //!< becomes playable
 };
 
 }  // End namespace midistar
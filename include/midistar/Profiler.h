@@ -0,0 +1,139 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIDISTAR_PROFILER_H_
+#define MIDISTAR_PROFILER_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <SFML/System.hpp>
+
+namespace midistar {
+
+/**
+ * The Profiler class records per-frame timing information for the Game, so
+ * that frame time can be compared against the amount of work on screen.
+ *
+ * Other parts of the Game can also publish named counters, which are sampled
+ * each frame and summarised in the report.
+ */
+class Profiler {
+ public:
+    /**
+     * Holds the measurements taken for a single frame.
+     */
+    struct FrameSample {
+        sf::Int64 frame_time;  //!< Frame time in microseconds
+        int num_objects;  //!< Number of GameObjects at the end of the frame
+        int num_song_notes;  //!< Number of song notes at the end of the frame
+    };
+
+    /**
+     * Constructor.
+     */
+    Profiler();
+
+    /**
+     * Adds a named counter.
+     *
+     * \param name The name of the counter, as shown in the report.
+     *
+     * \return The counter ID, used to set the counter.
+     */
+    int AddCounter(const std::string& name);
+
+    /**
+     * Marks the start of a frame.
+     */
+    void BeginFrame();
+
+    /**
+     * Marks the end of a frame and records a FrameSample for it.
+     *
+     * \param num_objects The number of GameObjects in the Game.
+     * \param num_song_notes The number of song notes in the Game.
+     */
+    void EndFrame(int num_objects, int num_song_notes);
+
+    /**
+     * Gets all recorded frame samples.
+     *
+     * \return Frame samples, in the order they were recorded.
+     */
+    const std::vector<FrameSample>& GetFrameSamples() const;
+
+    /**
+     * Determines whether or not the Profiler is recording frames.
+     *
+     * \return True if enabled. False otherwise.
+     */
+    bool IsEnabled() const;
+
+    /**
+     * Discards all recorded frame samples.
+     */
+    void Reset();
+
+    /**
+     * Sets the value of a counter for the current frame.
+     *
+     * \param id The counter ID returned by AddCounter().
+     * \param value The value of the counter.
+     */
+    void SetCounter(int id, sf::Int64 value);
+
+    /**
+     * Enables or disables frame recording.
+     *
+     * \param enabled True to record frames. False to ignore them.
+     */
+    void SetEnabled(bool enabled);
+
+    /**
+     * Writes a summary of the recorded frames. Frame times are reported
+     * overall and grouped by the number of song notes on screen.
+     *
+     * \param[out] out The stream to write to.
+     */
+    void WriteReport(std::ostream* out) const;
+
+ private:
+    /**
+     * Holds the samples of a named counter.
+     */
+    struct Counter {
+        std::string name;  //!< Counter name
+        sf::Int64 last;  //!< Most recent value
+        sf::Int64 max;  //!< Maximum value
+        int num_samples;  //!< Number of values
+        sf::Int64 total;  //!< Sum of values
+    };
+
+    static const int SONG_NOTES_PER_BUCKET = 25;  //!< Width of each song note
+                                                 //!< bucket in the report
+
+    sf::Clock clock_;  //!< Measures frame time
+    std::vector<Counter> counters_;  //!< Holds named counters
+    bool enabled_;  //!< Determines if frames are recorded
+    std::vector<FrameSample> samples_;  //!< Holds recorded frames
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_PROFILER_H_
@@ -0,0 +1,139 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDISTAR_RENDERSNAPSHOT_H_
+#define MIDISTAR_RENDERSNAPSHOT_H_
+
+#include <cstddef>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "midistar/EffectSystem.h"
+#include "midistar/GameObject.h"
+#include "midistar/NoteLayer.h"
+
+namespace midistar {
+
+/**
+ * The RenderSnapshot class holds everything needed to draw one tick of the
+ * Game: the positions, sizes and colours of GameObjects, the quads of visual
+ * effects and where the NoteLayer has scrolled to.
+ *
+ * Snapshots are copies, so they can be drawn on one thread while the Game
+ * carries on updating on another. Only GameObjects drawn with a rectangle or
+ * circle can be captured. Other drawables, such as sprites, refer to textures
+ * that might not outlive the snapshot.
+ */
+class RenderSnapshot {
+ public:
+    /**
+     * Constructor.
+     */
+    RenderSnapshot();
+
+    /**
+     * Captures the live effects of an EffectSystem. The effect atlas is not
+     * copied, but taken from the EffectSystem when the snapshot is drawn, so
+     * the EffectSystem must outlive the snapshot.
+     *
+     * \param effects The EffectSystem to capture.
+     */
+    void AddEffects(EffectSystem* effects);
+
+    /**
+     * Captures the shape of a GameObject.
+     *
+     * \param o The GameObject to capture.
+     */
+    void AddObject(GameObject* o);
+
+    /**
+     * Removes everything from the snapshot. Storage is kept, so snapshots can
+     * be reused without allocating.
+     *
+     * \param background The colour the snapshot is drawn over.
+     */
+    void Clear(const sf::Color& background);
+
+    /**
+     * Draws the snapshot, in the same order as the Game draws a tick.
+     *
+     * \param[in] target The render target to draw to.
+     */
+    void Draw(sf::RenderTarget* target) const;
+
+    /**
+     * Captures where the NoteLayer has scrolled to. The NoteLayer is not
+     * copied, so it must outlive the snapshot.
+     *
+     * \param layer The NoteLayer to draw.
+     * \param first The schedule index of the first note that has not been
+     * activated.
+     * \param song_time The time in milliseconds since the song started.
+     */
+    void SetNoteLayer(NoteLayer* layer, std::size_t first, double song_time);
+
+ private:
+    /**
+     * Holds the kind of drawable a Shape was captured from.
+     */
+    enum ShapeType {
+        CIRCLE,
+        RECTANGLE
+    };
+
+    /**
+     * Holds a copy of a GameObject's shape.
+     */
+    struct Shape {
+        sf::Color fill_colour;  //!< Fill colour
+        sf::Color outline_colour;  //!< Outline colour
+        float outline_thickness;  //!< Outline thickness
+        sf::Vector2f origin;  //!< Local origin
+        std::size_t point_count;  //!< Number of circle points
+        sf::Vector2f position;  //!< Position on screen
+        float rotation;  //!< Rotation in degrees
+        sf::Vector2f scale;  //!< Scale factors
+        sf::Vector2f size;  //!< Rectangle size, or circle radius in x
+        ShapeType type;  //!< Kind of drawable
+    };
+
+    /**
+     * Copies the properties common to all SFML shapes.
+     *
+     * \param s The SFML shape.
+     * \param type The kind of drawable.
+     * \param size Rectangle size, or circle radius in x.
+     * \param point_count Number of circle points.
+     */
+    void AddShape(const sf::Shape& s, ShapeType type, const sf::Vector2f& size
+            , std::size_t point_count);
+
+    sf::Color background_;  //!< Colour the snapshot is drawn over
+    sf::VertexArray effect_vertices_;  //!< Effect quads
+    EffectSystem* effects_;  //!< EffectSystem whose atlas quads are mapped to
+    std::size_t first_note_;  //!< First NoteLayer note to draw
+    NoteLayer* note_layer_;  //!< NoteLayer to draw, if any
+    std::vector<Shape> shapes_;  //!< GameObject shapes, in drawing order
+    double song_time_;  //!< Song time the NoteLayer is scrolled to
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_RENDERSNAPSHOT_H_
@@ -0,0 +1,84 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIDISTAR_SNAPSHOTBUFFER_H_
+#define MIDISTAR_SNAPSHOTBUFFER_H_
+
+#include <atomic>
+
+#include "midistar/RenderSnapshot.h"
+
+namespace midistar {
+
+/**
+ * The SnapshotBuffer class hands RenderSnapshots from the simulation thread
+ * to the window thread without either of them waiting on the other.
+ *
+ * It holds three snapshots: the back snapshot, being written by the
+ * simulation thread; the front snapshot, being drawn by the window thread; and
+ * a middle snapshot, which is the latest one published. Publishing swaps the
+ * back and middle snapshots, and acquiring swaps the middle and front
+ * snapshots if a newer one has been published. Both swaps are a single atomic
+ * exchange. Snapshots the window thread is too slow to draw are skipped.
+ */
+class SnapshotBuffer {
+ public:
+    /**
+     * Constructor.
+     */
+    SnapshotBuffer();
+
+    /**
+     * Gets the latest published snapshot. Only the window thread may call
+     * this. The snapshot stays valid until the next call.
+     *
+     * \return Latest snapshot. Until the first snapshot is published, this is
+     * an empty snapshot.
+     */
+    const RenderSnapshot& Acquire();
+
+    /**
+     * Gets the back snapshot, to be filled in. Only the simulation thread may
+     * call this.
+     *
+     * \return Back snapshot.
+     */
+    RenderSnapshot& GetBack();
+
+    /**
+     * Publishes the back snapshot, making it the latest one. Only the
+     * simulation thread may call this.
+     */
+    void Publish();
+
+ private:
+    static const int FRESH = 4;  //!< Set in middle_ when the middle snapshot
+                                         //!< has not been acquired yet
+    static const int INDEX_MASK = 3;  //!< Masks the snapshot index in middle_
+    static const int NUM_SNAPSHOTS = 3;  //!< Number of snapshots
+
+    int back_;  //!< Index of the snapshot being written
+    int front_;  //!< Index of the snapshot being drawn
+    std::atomic<int> middle_;  //!< Index of the latest snapshot, and FRESH
+    RenderSnapshot snapshots_[NUM_SNAPSHOTS];  //!< Snapshot storage
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_SNAPSHOTBUFFER_H_
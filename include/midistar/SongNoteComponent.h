@@ -33,11 +33,6 @@ class SongNoteComponent : public Component {
      * Constructor.
      */
     SongNoteComponent();
-
-    /**
-     * \copydoc Component::Update()
-     */
-    virtual void Update(Game* g, GameObject* o, int delta);
 };
 
 }   // End namespace midistar
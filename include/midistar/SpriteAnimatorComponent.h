@@ -22,12 +22,16 @@
 #include "midistar/Component.h"
 #include "midistar/Game.h"
 #include "midistar/GameObject.h"
+#include "midistar/TimerWheel.h"
 
 namespace midistar {
 
 /**
  * The SpriteAnimatorComponent class animates GameObjects that contain an
  * sf::Sprite instance which uses a spritesheet.
+ *
+ * Frames are changed by a repeating timer on the Game's TimerWheel, so the
+ * component sleeps once the animation has started.
  */
 class SpriteAnimatorComponent : public Component {
  public:
@@ -36,17 +40,27 @@ class SpriteAnimatorComponent : public Component {
      */
     SpriteAnimatorComponent(int sprite_size, int row, int col, int fps);
 
+    /**
+     * Destructor. Cancels the next frame.
+     */
+    ~SpriteAnimatorComponent();
+
     /**
      * \copydoc Component::Update()
      */
     virtual void Update(Game* g, GameObject* o, int delta);
 
  private:
+    void NextFrame(GameObject* o);  //!< Shows the next frame and schedules
+                                                            //!< the one after
+
     int col_;  //!< The column in the sprite sheet
-    int last_frame_delta_;  //!< The time since last frame
     const int ms_per_frame_;  //!< Milliseconds per frame
     int row_;  //!< The row in the sprite sheet
     const int sprite_size_;  //!< The size of each sprite
+    int timer_;  //!< Holds ID of the next frame timer
+    TimerWheel* timers_;  //!< Holds the TimerWheel running timer_, or nullptr
+                                                  //!< if the animation hasn't started
 };
 
 }   // End namespace midistar
@@ -0,0 +1,127 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIDISTAR_TIMERWHEEL_H_
+#define MIDISTAR_TIMERWHEEL_H_
+
+#include <functional>
+#include <vector>
+
+namespace midistar {
+
+/**
+ * The TimerWheel class calls functions after a delay, so that Components
+ * waiting on a deadline don't have to count down every tick.
+ *
+ * Timers are kept in a hierarchical timer wheel. Each level is a ring of
+ * slots, and each slot covers SLOTS_PER_LEVEL times as much time as a slot on
+ * the level below. Timers are placed on the lowest level that can hold their
+ * deadline, and are moved down a level as their deadline gets closer. Adding
+ * and cancelling a timer is O(1), and advancing the wheel only visits the
+ * slots that come due, so timers that aren't due cost nothing.
+ */
+class TimerWheel {
+ public:
+    static const int NO_TIMER = -1;  //!< Timer ID that refers to no timer
+
+    /**
+     * The function called when a timer is due.
+     */
+    typedef std::function<void()> Callback;
+
+    /**
+     * Constructor.
+     */
+    TimerWheel();
+
+    /**
+     * Advances time, calling the functions of all timers that come due, in
+     * order of their deadlines.
+     *
+     * \param delta The time in milliseconds since the last tick.
+     */
+    void Advance(int delta);
+
+    /**
+     * Cancels a timer. Timers are removed once they are due, so their IDs
+     * must not be used after their function has been called.
+     *
+     * \param id The timer ID returned by Schedule().
+     */
+    void Cancel(int id);
+
+    /**
+     * Gets the number of pending timers.
+     *
+     * \return Number of timers.
+     */
+    int GetCount() const;
+
+    /**
+     * Gets the time the wheel has advanced to.
+     *
+     * \return The time in milliseconds since the wheel was created.
+     */
+    int GetTime() const;
+
+    /**
+     * Adds a timer. Timers with no delay are called on the next Advance().
+     *
+     * \param delay The time in milliseconds until the timer is due.
+     * \param callback The function to call when the timer is due.
+     *
+     * \return The timer ID, which can be used to cancel the timer.
+     */
+    int Schedule(int delay, Callback callback);
+
+ private:
+    static const int LEVEL_BITS = 6;  //!< Bits of time covered by each level
+    static const int NUM_LEVELS = 4;  //!< Number of levels in the wheel
+    static const int SLOTS_PER_LEVEL = 1 << LEVEL_BITS;  //!< Slots in a level
+    static const int SLOT_MASK = SLOTS_PER_LEVEL - 1;  //!< Selects a slot
+    static const int MAX_DELAY = (1 << (LEVEL_BITS * NUM_LEVELS)) - 1;
+                          //!< Longest delay the wheel can hold without cascading
+
+    /**
+     * Holds a timer and its place in a slot list.
+     */
+    struct Timer {
+        Callback callback;  //!< Function to call when due
+        int deadline;  //!< Time the timer is due
+        bool live;  //!< Determines if the timer is pending
+        int next;  //!< Next timer in the slot, or NO_TIMER
+        int prev;  //!< Previous timer in the slot, or NO_TIMER
+        int slot;  //!< Index of the slot holding the timer
+    };
+
+    void Cascade(int level);  //!< Moves the timers in the current slot of a
+                                                 //!< level down to lower levels
+    void Insert(int id);  //!< Adds a timer to the slot for its deadline
+    void Unlink(int id);  //!< Removes a timer from its slot
+
+    int count_;  //!< Number of pending timers
+    std::vector<int> free_timers_;  //!< Indices of timers that can be reused
+    int heads_[NUM_LEVELS * SLOTS_PER_LEVEL];  //!< First timer in each slot
+    int tails_[NUM_LEVELS * SLOTS_PER_LEVEL];  //!< Last timer in each slot
+    int time_;  //!< Time the wheel has advanced to
+    std::vector<Timer> timers_;  //!< Contiguous timer buffer
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_TIMERWHEEL_H_
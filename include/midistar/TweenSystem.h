@@ -0,0 +1,167 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIDISTAR_TWEENSYSTEM_H_
+#define MIDISTAR_TWEENSYSTEM_H_
+
+#include <utility>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "midistar/EffectSystem.h"
+#include "midistar/GameObject.h"
+
+namespace midistar {
+
+/**
+ * The TweenSystem class animates properties of GameObjects and EffectSystem
+ * effects, such as their size or transparency, from their current value to a
+ * target value over a set time.
+ *
+ * Tweens are not Components. Every tween is kept in a set of contiguous
+ * arrays, and all tweens are advanced together in a single loop each tick.
+ * Tweens are time-based, so they look the same at any frame rate.
+ */
+class TweenSystem {
+ public:
+    /**
+     * Defines the properties that can be animated.
+     */
+    enum Property {
+        WIDTH  //!< Width, keeping the centre in place
+        , HEIGHT  //!< Height, keeping the centre in place
+        , ALPHA  //!< Fill colour alpha of shapes, or colour alpha of effects
+        , OUTLINE_THICKNESS  //!< Outline thickness of shapes
+    };
+
+    /**
+     * Defines how a tween moves between its start and end values.
+     */
+    enum Easing {
+        LINEAR  //!< Constant speed
+        , EASE_IN  //!< Starts slow and speeds up
+        , EASE_OUT  //!< Starts fast and slows down
+    };
+
+    /**
+     * Constructor.
+     */
+    TweenSystem();
+
+    /**
+     * Adds a tween, starting from the current value of the property. Any
+     * tween of the same property of the GameObject is replaced.
+     *
+     * \param o The GameObject to animate.
+     * \param property The property to animate.
+     * \param end The value of the property when the tween finishes.
+     * \param duration The time in milliseconds the tween takes.
+     * \param easing How the tween moves between its start and end values.
+     *
+     * \return True if the tween was added. False if the GameObject doesn't
+     * have the property.
+     */
+    bool Add(GameObject* o, Property property, float end, int duration
+            , Easing easing);
+
+    /**
+     * Adds a tween of an effect, starting from the current value of the
+     * property. Any tween of the same property of the effect is replaced. An
+     * effect whose alpha is tweened to zero is removed once the tween
+     * finishes.
+     *
+     * \param effects The EffectSystem holding the effect.
+     * \param effect The effect ID returned by EffectSystem::Add().
+     * \param property The property to animate.
+     * \param end The value of the property when the tween finishes.
+     * \param duration The time in milliseconds the tween takes.
+     * \param easing How the tween moves between its start and end values.
+     *
+     * \return True if the tween was added. False if effects don't have the
+     * property.
+     */
+    bool Add(EffectSystem* effects, int effect, Property property, float end
+            , int duration, Easing easing);
+
+    /**
+     * Removes all tweens.
+     */
+    void Clear();
+
+    /**
+     * Gets the number of running tweens.
+     *
+     * \return Number of tweens.
+     */
+    int GetCount() const;
+
+    /**
+     * Removes all tweens of a GameObject. This must be called before the
+     * GameObject is deleted.
+     *
+     * \param o The GameObject.
+     */
+    void Remove(GameObject* o);
+
+    /**
+     * Removes all tweens of an effect. This must be called before the effect
+     * is removed from its EffectSystem.
+     *
+     * \param effects The EffectSystem holding the effect.
+     * \param effect The effect ID.
+     */
+    void Remove(EffectSystem* effects, int effect);
+
+    /**
+     * Advances all tweens, and removes the tweens that have finished.
+     *
+     * \param delta The time in milliseconds since the last tick.
+     */
+    void Update(int delta);
+
+ private:
+    void Apply(std::size_t i);  //!< Sets a tween's property to its value
+    std::size_t Insert(GameObject* o, EffectSystem* effects, int effect
+            , Property property, float start, float end, int duration
+            , Easing easing);  //!< Adds a tween, replacing any of the same
+                    //!< target and property. Returns the index of the tween
+    void Move(std::size_t from, std::size_t to);  //!< Moves a tween to
+                                                    //!< another index
+    void Resize(std::size_t size);  //!< Resizes every tween array
+
+    std::vector<float> curves_;  //!< Easing curve. Eased progress is
+                                            //!< t + curve * t * (1 - t)
+    std::vector<float> durations_;  //!< Time each tween takes
+    std::vector<int> effect_ids_;  //!< Effect of each tween, or NO_EFFECT
+    std::vector<EffectSystem*> effect_systems_;  //!< EffectSystem of each
+                                                  //!< effect tween, or nullptr
+    std::vector<float> elapsed_;  //!< Time since each tween started
+    std::vector<float> ends_;  //!< Final value of each tween
+    std::vector<std::pair<EffectSystem*, int>> faded_;  //!< Effects that
+                                       //!< faded out this tick, to be removed
+    std::vector<GameObject*> objects_;  //!< GameObject of each tween, or
+                                                       //!< nullptr for effects
+    std::vector<Property> properties_;  //!< Property of each tween
+    std::vector<sf::Shape*> shapes_;  //!< Shape of each GameObject, if any
+    std::vector<float> starts_;  //!< First value of each tween
+    std::vector<float> values_;  //!< Current value of each tween
+};
+
+}  // End namespace midistar
+
+#endif  // MIDISTAR_TWEENSYSTEM_H_
@@ -19,6 +19,7 @@
 #ifndef MIDISTAR_UTILITY_H_
 #define MIDISTAR_UTILITY_H_
 
+#include <string>
 #include <vector>
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
@@ -46,6 +47,22 @@ class Utility {
      */
     static const std::vector<sf::Keyboard::Key>& GetQwertyKeys();
 
+    /**
+     * Gets the amount of physical memory used by the process.
+     *
+     * \return Resident memory in bytes, or -1 if it can't be measured on this
+     * platform.
+     */
+    static long long GetResidentMemory();
+
+    /**
+     * Gets the directory that temporary files should be written to. The
+     * TMPDIR, TMP and TEMP environment variables are checked, in that order.
+     *
+     * \return Path of the directory, without a trailing separator.
+     */
+    static std::string GetTempDirectory();
+
     /**
      * Transforms a colour by a given multiplier.
      *
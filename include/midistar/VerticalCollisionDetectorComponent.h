@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "midistar/Component.h"
+#include "midistar/ContactSpan.h"
 #include "midistar/Game.h"
 #include "midistar/GameObject.h"
 
@@ -30,6 +31,11 @@ namespace midistar {
 /**
  * The VerticalCollisionDetectorComponent class detects collisions between the
  * its owner and the other GameObjects on the Y axis.
+ *
+ * Contacts persist between updates, so each update also reports which contacts
+ * have just started (entered) and which have just ended (exited). Contacts are
+ * handed out as ContactSpans over a buffer owned by the detector, which is
+ * reused each update.
  */
 class VerticalCollisionDetectorComponent : public Component {
  public:
@@ -39,11 +45,30 @@ class VerticalCollisionDetectorComponent : public Component {
      VerticalCollisionDetectorComponent();
 
      /**
-      * Finds GameObjects that are colliding with the owner.
+      * Gets the GameObjects that are colliding with the owner. Contacts that
+      * have just started come first, followed by contacts that have carried
+      * on from the last update.
       *
       * \return Colliding GameObjects.
       */
-     const std::vector<GameObject*>& GetCollidingWith();
+     ContactSpan GetCollidingWith() const;
+
+     /**
+      * Gets the GameObjects that started colliding with the owner in the last
+      * update.
+      *
+      * \return Newly colliding GameObjects.
+      */
+     ContactSpan GetEntered() const;
+
+     /**
+      * Gets the GameObjects that stopped colliding with the owner in the last
+      * update. GameObjects that were removed from the Game while colliding are
+      * included, so exited GameObjects must only be compared, never used.
+      *
+      * \return GameObjects that are no longer colliding.
+      */
+     ContactSpan GetExited() const;
 
      /**
       * Determines whether or not the owner is currently colliding with another
@@ -51,7 +76,7 @@ class VerticalCollisionDetectorComponent : public Component {
       *
       * \return True if a collision is occuring. False otherwise.
       */
-     bool GetIsColliding();
+     bool GetIsColliding() const;
 
      /**
       * \copydoc Component::Update()
@@ -59,7 +84,12 @@ class VerticalCollisionDetectorComponent : public Component {
      virtual void Update(Game* g, GameObject* o, int delta);
 
  private:
-     std::vector<GameObject*> colliding_with_;  //!< Holds colliding objects
+     std::vector<GameObject*> contacts_;  //!< Holds entered, then stayed, then
+                                              //!< exited objects of this update
+     std::size_t num_colliding_;  //!< Number of entered and stayed objects
+     std::size_t num_entered_;  //!< Number of entered objects
+     std::vector<GameObject*> previous_;  //!< Holds contacts_ of the previous
+                                         //!< update, reused as the next buffer
 };
 
 }   // End namespace midistar
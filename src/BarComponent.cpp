@@ -24,7 +24,4 @@ BarComponent::BarComponent()
         : Component{Component::BAR} {
 }
 
-void BarComponent::Update(Game*, GameObject*, int) {
-}
-
 }   // End namespace midistar
@@ -0,0 +1,91 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midistar/Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "midistar/Config.h"
+#include "midistar/Game.h"
+#include "midistar/MidiFileGenerator.h"
+#include "midistar/Utility.h"
+
+namespace midistar {
+
+bool Benchmark::Run() {
+    // Auto play is enabled so that notes are played, and play effects are
+    // included in the measurements.
+    Config::GetInstance().SetAutomaticallyPlay(true);
+
+    for (double nps : Config::GetInstance().GetBenchmarkSweep()) {
+        for (const auto& mode : {"piano", "drum", "default"}) {
+            if (!RunMode(mode, nps)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool Benchmark::RunMode(const std::string& mode, double notes_per_second) {
+    // Generate the song. Drum mode has one instrument per unique note, so we
+    // limit drum songs to a General MIDI percussion range.
+    auto params = Config::GetInstance().GetMidiFileGeneratorParameters();
+    params.notes_per_second = notes_per_second;
+    if (mode == "drum") {
+        params.percussion = true;
+        params.lowest_key = DRUM_LOWEST_KEY;
+        params.highest_key = DRUM_HIGHEST_KEY;
+    }
+    std::ostringstream file_name;
+    file_name << Utility::GetTempDirectory() << "/midistar_benchmark_" << mode
+        << "_" << notes_per_second << ".mid";
+    MidiFileGenerator generator{params};
+    if (!generator.Write(file_name.str())) {
+        return false;
+    }
+
+    // Play the song headlessly on a fixed clock
+    Config::GetInstance().SetGameMode(mode);
+    Config::GetInstance().SetMidiFileName(file_name.str());
+    int max_fps = Config::GetInstance().GetMaximumFramesPerSecond();
+    int delta = max_fps > 0 ? std::max(1000 / max_fps, 1) : DEFAULT_FRAME_TIME;
+
+    Game game{true};
+    bool ok = game.Init();
+
+    // The song is read while the game initialises, so its file can go now
+    std::remove(file_name.str().c_str());
+    if (!ok) {
+        return false;
+    }
+    game.GetProfiler().SetEnabled(true);
+    for (int ticks = 0; game.IsRunning() && ticks < MAX_TICKS; ++ticks) {
+        game.Tick(delta);
+    }
+
+    std::cout << "\n== game_mode: " << mode << ", notes_per_second: "
+        << notes_per_second << ", frame delta: " << delta << "ms ==\n";
+    game.GetProfiler().WriteReport(&std::cout);
+    return true;
+}
+
+}  // End namespace midistar
@@ -24,7 +24,4 @@ CollidableComponent::CollidableComponent()
         : Component{Component::COLLIDABLE} {
 }
 
-void CollidableComponent::Update(Game*, GameObject*, int) {
-}
-
 }   // End namespace midistar
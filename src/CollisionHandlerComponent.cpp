@@ -18,8 +18,6 @@
 
 #include "midistar/CollisionHandlerComponent.h"
 
-#include "midistar/VerticalCollisionDetectorComponent.h"
-
 namespace midistar {
 
 CollisionHandlerComponent::CollisionHandlerComponent(ComponentType type)
@@ -33,7 +31,7 @@ void CollisionHandlerComponent::Update(Game* g, GameObject* o, int delta) {
         return;
     }
 
-    HandleCollisions(g, o, delta, detector->GetCollidingWith());
+    HandleCollisions(g, o, delta, *detector);
 }
 
 }  // End namespace midistar
@@ -20,6 +20,19 @@
 
 namespace midistar {
 
+const char* const Component::TYPE_NAMES[NUM_COMPONENTS] {
+    "song_note", "instrument", "bar", "collidable", "note_info"
+    , "instrument_input_handler", "instrument_auto_play", "transformation"
+    , "invert_colour", "midi_note", "physics", "delete_offscreen"
+    , "vertical_collision_detector", "note_collision_handler", "resize"
+    , "sprite_animator", "delayed_component"
+};
+
+const bool Component::UPDATED[NUM_COMPONENTS] {
+    false, false, false, false, false  // Song note to note info are tags/data
+    , true, true, true, true, true, true, true, true, true, true, true, true
+};
+
 Component::Component(ComponentType type)
         : type_{type} {
 }
@@ -27,8 +40,19 @@ Component::Component(ComponentType type)
 Component::~Component() {
 }
 
+const char* Component::GetTypeName(ComponentType type) {
+    return TYPE_NAMES[type];
+}
+
 ComponentType Component::GetType() {
     return type_;
 }
 
+bool Component::IsUpdated(ComponentType type) {
+    return UPDATED[type];
+}
+
+void Component::Update(Game*, GameObject*, int) {
+}
+
 }  // End namespace midistar
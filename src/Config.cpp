@@ -31,21 +31,46 @@ Config& Config::GetInstance() {
 Config::Config()
         : audio_driver_{""}
         , auto_play_{false}
+        , benchmark_{false}
+        , benchmark_sweep_{10, 50, 200}
         , fall_speed_multiplier_{0}
         , full_screen_{false}
         , game_mode_{""}
+        , generate_midi_file_{""}
+        , generator_params_{1, 108, 30.0, 21, 1.0, 0.1, "uniform", 20.0, 0, 1
+            , false, 1}
+        , input_first_{false}
         , instrument_midi_remapping_{}
         , instrument_midi_remapping_notes_{}
         , keyboard_first_note_{-1}
         , max_frames_per_second_{-1}
+        , max_spawn_passes_{4}
         , midi_file_channels_{}
         , midi_file_name_{""}
         , midi_file_repeat_{false}
         , midi_file_tracks_{}
+        , midi_in_channels_{-1}
+        , midi_in_ignore_{"active_sensing", "sysex", "timing"}
+        , midi_in_port_remapping_{}
+        , midi_in_port_remapping_notes_{}
+        , midi_in_ports_{"0"}
+        , midi_thru_{false}
+        , note_buffer_{false}
+        , playlist_{}
+        , profile_{false}
+        , record_input_{""}
+        , render_audio_{""}
+        , render_deadline_{0}
+        , render_frames_per_second_{60}
+        , render_threads_{0}
+        , render_video_{""}
+        , replay_input_{""}
         , screen_height_{-1}
         , screen_width_{-1}
         , show_third_party_{false}
-        , soundfont_path_{""} {
+        , simulation_thread_{false}
+        , soundfont_path_{""}
+        , tick_rate_{500} {
 }
 
 const std::string Config::GetAudioDriver() {
@@ -56,6 +81,14 @@ bool Config::GetAutomaticallyPlay() {
     return auto_play_;
 }
 
+bool Config::GetBenchmark() {
+    return benchmark_;
+}
+
+std::vector<int> Config::GetBenchmarkSweep() {
+    return benchmark_sweep_;
+}
+
 bool Config::GetFullScreen() {
     return full_screen_;
 }
@@ -64,19 +97,36 @@ const std::string Config::GetGameMode() {
     return game_mode_;
 }
 
+const std::string Config::GetGenerateMidiFile() {
+    return generate_midi_file_;
+}
+
+bool Config::GetInputFirst() {
+    return input_first_;
+}
+
 int Config::GetInstrumentMidiNoteRemapping(int note) {
-    return instrument_midi_remapping_.count(note) ?
-        instrument_midi_remapping_[note] : note;
+    // Called from the MIDI input threads, so nothing may be inserted
+    auto n = instrument_midi_remapping_.find(note);
+    return n == instrument_midi_remapping_.end() ? note : n->second;
 }
 
 int Config::GetMaximumFramesPerSecond() {
     return max_frames_per_second_;
 }
 
+int Config::GetMaximumSpawnPasses() {
+    return max_spawn_passes_;
+}
+
 std::vector<int> Config::GetMidiFileChannels() {
     return midi_file_channels_;
 }
 
+MidiFileGenerator::Parameters Config::GetMidiFileGeneratorParameters() {
+    return generator_params_;
+}
+
 const std::string Config::GetMidiFileName() {
     return midi_file_name_;
 }
@@ -93,14 +143,80 @@ std::vector<int> Config::GetMidiFileTracks() {
     return midi_file_tracks_;
 }
 
+std::vector<int> Config::GetMidiInChannels() {
+    return midi_in_channels_;
+}
+
+std::vector<std::string> Config::GetMidiInIgnore() {
+    return midi_in_ignore_;
+}
+
+int Config::GetMidiInPortNoteRemapping(int port, int note) {
+    // Called from the MIDI input threads, so nothing may be inserted
+    auto p = midi_in_port_remapping_.find(port);
+    if (p == midi_in_port_remapping_.end()) {
+        return note;
+    }
+    auto n = p->second.find(note);
+    return n == p->second.end() ? note : n->second;
+}
+
+std::vector<std::string> Config::GetMidiInPorts() {
+    return midi_in_ports_;
+}
+
 int Config::GetMidiOutVelocity() {
     return MIDI_OUT_VELOCITY;
 }
 
+bool Config::GetMidiThru() {
+    return midi_thru_;
+}
+
 double Config::GetFallSpeedMultiplier() {
     return fall_speed_multiplier_;
 }
 
+bool Config::GetNoteBuffer() {
+    return note_buffer_;
+}
+
+std::vector<std::string> Config::GetPlaylist() {
+    return playlist_;
+}
+
+bool Config::GetProfile() {
+    return profile_;
+}
+
+const std::string Config::GetRecordInput() {
+    return record_input_;
+}
+
+const std::string Config::GetRenderAudio() {
+    return render_audio_;
+}
+
+int Config::GetRenderDeadline() {
+    return render_deadline_;
+}
+
+int Config::GetRenderFramesPerSecond() {
+    return render_frames_per_second_;
+}
+
+int Config::GetRenderThreads() {
+    return render_threads_;
+}
+
+const std::string Config::GetRenderVideo() {
+    return render_video_;
+}
+
+const std::string Config::GetReplayInput() {
+    return replay_input_;
+}
+
 int Config::GetScreenHeight() {
     return screen_height_;
 }
@@ -118,10 +234,18 @@ bool Config::GetShowThirdParty() {
     return show_third_party_;
 }
 
+bool Config::GetSimulationThread() {
+    return simulation_thread_;
+}
+
 const std::string Config::GetSoundFontPath() {
     return soundfont_path_;
 }
 
+int Config::GetTickRate() {
+    return tick_rate_;
+}
+
 bool Config::ParseOptions(int argc, char** argv) {
     CLI::App app {};
     InitCliApp(&app);
@@ -144,9 +268,32 @@ bool Config::ParseOptions(int argc, char** argv) {
             instrument_midi_remapping_notes_[i+1];
     }
 
+    if (midi_in_port_remapping_notes_.size() % 3) {
+        std::cerr << "Error: \"midi_in_port_remapping\" config option must "
+            "have a length perfectly divisble by 3.\n";
+        return false;
+    }
+    for (unsigned i=0; i < midi_in_port_remapping_notes_.size(); i += 3) {
+        midi_in_port_remapping_[midi_in_port_remapping_notes_[i]][
+            midi_in_port_remapping_notes_[i+1]] =
+            midi_in_port_remapping_notes_[i+2];
+    }
+
     return true;
 }
 
+void Config::SetAutomaticallyPlay(bool auto_play) {
+    auto_play_ = auto_play;
+}
+
+void Config::SetGameMode(const std::string& game_mode) {
+    game_mode_ = game_mode;
+}
+
+void Config::SetMidiFileName(const std::string& midi_file_name) {
+    midi_file_name_ = midi_file_name;
+}
+
 void Config::InitCliApp(CLI::App* app) {
     app->option_defaults()->required();
     app->add_option("--audio_driver", audio_driver_, "The audio driver to use "
@@ -169,6 +316,29 @@ void Config::InitCliApp(CLI::App* app) {
             "whether or not to continuously repeat the MIDI file.");
     app->add_option("--midi_file_tracks", midi_file_tracks_, "The MIDI tracks "
             "to read notes from. -1 will enable all tracks.");
+    app->add_option("--midi_in_channels", midi_in_channels_, "The MIDI input "
+            "port channels to read notes from. -1 will enable all channels.")
+            ->required(false);
+    app->add_option("--midi_in_ignore", midi_in_ignore_, "The types of MIDI "
+            "input port messages to drop as soon as they arrive. By default, "
+            "active sensing, SysEx and timing messages are dropped.")->
+            required(false);
+    app->add_option("--midi_in_port_remapping", midi_in_port_remapping_notes_
+            , "Remaps MIDI notes played on one MIDI input port to another "
+            "note. Mappings are formatted as a list of triples, where the "
+            "first value is the index of the port in --midi_in_ports, the "
+            "second is the original note and the third is the mapped note.")
+            ->required(false);
+    app->add_option("--midi_in_ports", midi_in_ports_, "The MIDI input ports "
+            "to read from, each given as a port number or part of a port "
+            "name. Ports that are unplugged or plugged in later are picked up "
+            "while the game runs.")->required(false);
+    app->add_flag("--midi_thru", midi_thru_, "Adding this flag plays notes "
+            "from the MIDI input port as soon as they arrive, instead of when "
+            "the game next ticks.");
+    app->add_option("--playlist", playlist_, "MIDI files to play one after "
+            "the other, instead of the file given by --midi_file.")->required(
+            false);
     app->add_option("--instrument_midi_remapping"
             , instrument_midi_remapping_notes_,
             "Remaps specified instrument MIDI notes to another note. Mappings "
@@ -186,6 +356,86 @@ void Config::InitCliApp(CLI::App* app) {
     app->add_flag("--show_third_party", show_third_party_, "Adding this flag "
             "prints out the copyright notices of third-party projects that are "
             "used by midistar.");
+
+    // Performance testing options. These are not required.
+    app->add_flag("--profile", profile_, "Adding this flag records frame "
+            "times and prints a report when the game finishes.")->required(
+            false);
+    app->add_option("--max_spawn_passes", max_spawn_passes_, "The maximum "
+            "number of extra update passes each frame for objects spawned "
+            "during that frame.")->required(false);
+    app->add_flag("--note_buffer", note_buffer_, "Adding this flag draws "
+            "falling song notes from a static vertex buffer, scrolled with the "
+            "song, until they reach the instrument.")->required(false);
+    app->add_flag("--simulation_thread", simulation_thread_, "Adding this "
+            "flag runs the simulation on its own thread at a fixed tick rate. "
+            "The window thread only draws the latest snapshot of the game.")->
+            required(false);
+    app->add_option("--tick_rate", tick_rate_, "The number of simulation "
+            "ticks per second with --simulation_thread.")->required(false);
+    app->add_flag("--input_first", input_first_, "Adding this flag handles "
+            "input and spawns song notes at the start of each tick, before "
+            "updating and drawing, instead of at the end.")->required(false);
+    app->add_option("--render_deadline", render_deadline_, "The time in "
+            "milliseconds after the start of each tick at which input is "
+            "sampled again, just before drawing. 0 disables this.")->required(
+            false);
+    app->add_option("--record_input", record_input_, "Records keyboard and "
+            "MIDI input to this path, so the session can be replayed.")->
+            required(false);
+    app->add_option("--replay_input", replay_input_, "Replays keyboard and "
+            "MIDI input recorded with --record_input instead of using live "
+            "input.")->required(false);
+    app->add_option("--render_video", render_video_, "Renders the game "
+            "offline instead of playing it, writing each frame as a PNG file "
+            "named with this prefix and the frame number. \"-\" writes raw "
+            "RGBA frames to standard output.")->required(false);
+    app->add_option("--render_audio", render_audio_, "Renders the game "
+            "offline instead of playing it, writing the audio to this WAV "
+            "file.")->required(false);
+    app->add_option("--render_fps", render_frames_per_second_, "The frame "
+            "rate of offline renders.")->required(false);
+    app->add_option("--render_threads", render_threads_, "The number of "
+            "threads used to encode rendered frames. 0 uses one per hardware "
+            "thread.")->required(false);
+    app->add_flag("--benchmark", benchmark_, "Adding this flag runs the "
+            "headless benchmark suite instead of the game.")->required(false);
+    app->add_option("--benchmark_sweep", benchmark_sweep_, "The notes per "
+            "second values to run the benchmark suite with.")->required(false);
+    app->add_option("--generate_midi_file", generate_midi_file_, "Writes a "
+            "synthetic MIDI file to this path instead of running the game.")->
+            required(false);
+    app->add_option("--generator_chord_width", generator_params_.chord_width,
+            "The number of notes in each generated chord.")->required(false);
+    app->add_option("--generator_highest_key", generator_params_.highest_key,
+            "The highest generated MIDI key.")->required(false);
+    app->add_option("--generator_length", generator_params_.length, "The "
+            "length of generated songs in seconds.")->required(false);
+    app->add_option("--generator_lowest_key", generator_params_.lowest_key,
+            "The lowest generated MIDI key.")->required(false);
+    app->add_option("--generator_max_note_length"
+            , generator_params_.max_note_length, "The maximum generated note "
+            "length in seconds.")->required(false);
+    app->add_option("--generator_min_note_length"
+            , generator_params_.min_note_length, "The minimum generated note "
+            "length in seconds.")->required(false);
+    app->add_option("--generator_note_length_distribution"
+            , generator_params_.note_length_distribution, "The distribution "
+            "of generated note lengths. One of \"fixed\", \"uniform\" or "
+            "\"exponential\".")->required(false);
+    app->add_option("--generator_notes_per_second"
+            , generator_params_.notes_per_second, "The number of generated "
+            "notes started per second.")->required(false);
+    app->add_option("--generator_tempo_changes"
+            , generator_params_.num_tempo_changes, "The number of tempo "
+            "changes in generated songs.")->required(false);
+    app->add_option("--generator_tracks", generator_params_.num_tracks, "The "
+            "number of tracks in generated songs.")->required(false);
+    app->add_flag("--generator_percussion", generator_params_.percussion,
+            "Adding this flag writes generated notes to the percussion "
+            "channel.")->required(false);
+    app->add_option("--generator_seed", generator_params_.seed, "The random "
+            "seed for generated songs.")->required(false);
 }
 
 }  // End namespace midistar
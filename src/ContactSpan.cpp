@@ -0,0 +1,50 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midistar/ContactSpan.h"
+
+#include <algorithm>
+
+namespace midistar {
+
+ContactSpan::ContactSpan(GameObject* const* begin, GameObject* const* end)
+        : begin_{begin}
+        , end_{end} {
+}
+
+GameObject* const* ContactSpan::begin() const {
+    return begin_;
+}
+
+bool ContactSpan::Contains(const GameObject* o) const {
+    return std::find(begin_, end_, o) != end_;
+}
+
+GameObject* const* ContactSpan::end() const {
+    return end_;
+}
+
+std::size_t ContactSpan::GetSize() const {
+    return end_ - begin_;
+}
+
+bool ContactSpan::IsEmpty() const {
+    return begin_ == end_;
+}
+
+}  // End namespace midistar
@@ -45,10 +45,16 @@ DefaultGameObjectFactory::DefaultGameObjectFactory(double note_speed)
             static_cast<double>(NUM_MIDI_KEYS)} {
 }
 
-GameObject* DefaultGameObjectFactory::CreateNotePlayEffect(GameObject*) {
+GameObjectFactory* DefaultGameObjectFactory::Create(double note_speed, const
+        MidiFileIn&) {
+    return new DefaultGameObjectFactory(note_speed);
+}
+
+bool DefaultGameObjectFactory::CreateNotePlayEffect(
+        GameObject*
+        , EffectSystem::Effect*) {
     // NOTE: This feature is not implemented for the DefaultGameObjectFactory.
-    auto* rect = new sf::RectangleShape{};
-    return new GameObject{rect, 0, 0, 0, 0};
+    return false;
 }
 
 std::vector<GameObject*> DefaultGameObjectFactory::CreateInstrument() {
@@ -83,15 +89,15 @@ GameObject* DefaultGameObjectFactory::CreateSongNote(
     song_note->SetComponent(new PhysicsComponent{0, GetNoteSpeed()});
     song_note->SetComponent(new DeleteOffscreenComponent{});
     song_note->SetComponent(new VerticalCollisionDetectorComponent{});
-    song_note->SetComponent(new PianoSongNoteCollisionHandlerComponent{});
+    song_note->SetComponent(new PianoSongNoteCollisionHandlerComponent{
+            GetInstrumentY()});
     return song_note;
 }
 
 GameObject* DefaultGameObjectFactory::CreateInstrumentNote(int note) {
     // Create underlying shape
     double x = note * note_width_;
-    double y = Config::GetInstance().GetScreenHeight() - INSTRUMENT_HEIGHT -
-        (Config::GetInstance().GetScreenHeight() * INSTRUMENT_HOVER_PERCENTAGE);
+    double y = GetInstrumentY();
     sf::RectangleShape* rect = new sf::RectangleShape{{static_cast<float>(
             note_width_), static_cast<float>(INSTRUMENT_HEIGHT)}};;
     rect->setFillColor(sf::Color::Red);
@@ -140,6 +146,11 @@ void DefaultGameObjectFactory::GetInstrumentKeyBinding(
     *shift = midi_key >= num_keys * 2;
 }
 
+double DefaultGameObjectFactory::GetInstrumentY() {
+    return Config::GetInstance().GetScreenHeight() - INSTRUMENT_HEIGHT -
+        (Config::GetInstance().GetScreenHeight() * INSTRUMENT_HOVER_PERCENTAGE);
+}
+
 bool DefaultGameObjectFactory::Init() {
     // We have nothing to initialise...
     return true;
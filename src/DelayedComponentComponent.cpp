@@ -24,22 +24,54 @@ DelayedComponentComponent::DelayedComponentComponent(
     Component* component, int delay)
         : Component{Component::DELAYED_COMPONENT}
         , component_{component}
-        , delay_{delay} {
+        , delay_{delay}
+        , owner_{nullptr}
+        , timer_{TimerWheel::NO_TIMER}
+        , timers_{nullptr} {
+}
+
+DelayedComponentComponent::~DelayedComponentComponent() {
+    if (timers_) {
+        timers_->Cancel(timer_);
+    }
+    delete component_;
 }
 
 void DelayedComponentComponent::SetRemainingDelay(int delay) {
     delay_ = delay;
+    if (timers_) {
+        timers_->Cancel(timer_);
+        ScheduleDelay();
+    }
 }
 
 void DelayedComponentComponent::Update(
-        Game*
+        Game* g
         , GameObject* o
-        , int delta) {
-    delay_ -= delta;
+        , int) {
     if (delay_ <= 0) {
-        o->SetComponent(component_);
-        o->DeleteComponent(GetType());
+        AddComponent(o);
+        return;
     }
+
+    // We sleep until the timer is due
+    owner_ = o;
+    timers_ = &g->GetTimers();
+    ScheduleDelay();
+    o->Sleep(GetType());
+}
+
+void DelayedComponentComponent::AddComponent(GameObject* o) {
+    o->SetComponent(component_);
+    component_ = nullptr;
+    o->DeleteComponent(GetType());
+}
+
+void DelayedComponentComponent::ScheduleDelay() {
+    timer_ = timers_->Schedule(delay_, [this] {
+        timer_ = TimerWheel::NO_TIMER;
+        AddComponent(owner_);
+    });
 }
 
 }  // End namespace midistar
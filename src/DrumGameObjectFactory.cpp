@@ -20,21 +20,19 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include "midistar/CollidableComponent.h"
 #include "midistar/Config.h"
 #include "midistar/DeleteOffscreenComponent.h"
 #include "midistar/DrumSongNoteCollisionHandlerComponent.h"
-#include "midistar/FadeOutEffectComponent.h"
 #include "midistar/Game.h"
 #include "midistar/InstrumentAutoPlayComponent.h"
 #include "midistar/InstrumentComponent.h"
 #include "midistar/InstrumentInputHandlerComponent.h"
 #include "midistar/NoteInfoComponent.h"
-#include "midistar/OutlineEffectComponent.h"
 #include "midistar/PhysicsComponent.h"
 #include "midistar/ResizeComponent.h"
-#include "midistar/ShrinkGrowComponent.h"
 #include "midistar/SongNoteComponent.h"
 #include "midistar/Utility.h"
 #include "midistar/VerticalCollisionDetectorComponent.h"
@@ -59,33 +57,60 @@ DrumGameObjectFactory::DrumGameObjectFactory(
         : GameObjectFactory{note_speed, BACKGROUND_COLOUR}
         , drum_radius_{Config::GetInstance().GetScreenWidth() /
             static_cast<double>(song_notes.size())}
+        , lane_index_{}
+        , lanes_{}
         , song_notes_{song_notes} {
     double max_drum_radius = std::min(Config::GetInstance().GetScreenHeight()
         , Config::GetInstance().GetScreenWidth()) * MAX_DRUM_RADIUS_PERCENT;
     drum_radius_ = std::min(drum_radius_, max_drum_radius);
     x_pos_offset_ = Config::GetInstance().GetScreenWidth() / 2  -
         (song_notes.size() * drum_radius_);
+    InitLanes();
 }
 
-GameObject* DrumGameObjectFactory::CreateNotePlayEffect(GameObject* note) {
-    auto circle = note->GetDrawformable<sf::CircleShape>();
-    if (!circle) {
-        auto rect = new sf::RectangleShape{{0, 0}};
-        return new GameObject{rect, 0, 0, 0, 0};
+GameObjectFactory* DrumGameObjectFactory::Create(double note_speed, const
+        MidiFileIn& file) {
+    return new DrumGameObjectFactory(note_speed, file.GetUniqueMidiNotes()
+            , file.GetMaximumNoteDuration());
+}
+
+void DrumGameObjectFactory::AnimateNotePlayEffect(
+        TweenSystem* tweens
+        , EffectSystem* effects
+        , int effect) {
+    // The effect grows quickly and fades out more slowly. Both slow down as
+    // they finish.
+    const auto& e = effects->Get(effect);
+    tweens->Add(effects, effect, TweenSystem::WIDTH, e.width * EFFECT_GROWTH
+            , EFFECT_GROW_DURATION, TweenSystem::EASE_OUT);
+    tweens->Add(effects, effect, TweenSystem::HEIGHT, e.height *
+            EFFECT_GROWTH, EFFECT_GROW_DURATION, TweenSystem::EASE_OUT);
+    tweens->Add(effects, effect, TweenSystem::ALPHA, 0, EFFECT_FADE_DURATION
+            , TweenSystem::EASE_OUT);
+}
+
+bool DrumGameObjectFactory::CreateNotePlayEffect(
+        GameObject* note
+        , EffectSystem::Effect* effect) {
+    if (!note->GetDrawformable<sf::CircleShape>()) {
+        return false;
     }
 
+    // A white circle over the note, which grows while fading out
     double w, h;
     note->GetSize(&w, &h);
     double x_pos, y_pos;
     note->GetPosition(&x_pos, &y_pos);
-    auto* effect_circle = new sf::CircleShape{static_cast<float>(w) / 2.0f};
-    effect_circle->setPosition({static_cast<float>(x_pos)
-        , static_cast<float>(y_pos)});
-    effect_circle->setFillColor(sf::Color::White);
-    auto effect_object = new GameObject{effect_circle, x_pos, y_pos, w, h};
-    effect_object->SetComponent(new FadeOutEffectComponent{});
-    effect_object->SetComponent(new ShrinkGrowComponent{w * 1.25f, h * 1.25f});
-    return effect_object;
+    effect->x = static_cast<float>(x_pos);
+    effect->y = static_cast<float>(y_pos);
+    effect->width = static_cast<float>(w);
+    effect->height = static_cast<float>(h);
+    effect->colour = sf::Color::White;
+    effect->row = 0;
+    effect->frame = 0;
+    effect->num_frames = 1;
+    effect->ms_per_frame = 0;
+    return true;
 }
 
 std::vector<GameObject*> DrumGameObjectFactory::CreateInstrument() {
@@ -103,14 +128,13 @@ GameObject* DrumGameObjectFactory::CreateSongNote(
         , int vel
         , double) {
     // Create underlying shape
-    double x = GetXPosition(note);
+    const Lane& lane = GetLane(note);
     double padding_px = drum_radius_ * DRUM_PADDING_PERCENT;
     double padded_radius = drum_radius_ - padding_px * 2;
     sf::CircleShape* circle = new sf::CircleShape{ static_cast<float>(
         padded_radius) };
 
-    auto colour = DRUM_COLOURS[GetNoteUniqueIndex(note) % NUM_DRUM_COLOURS];
-    circle->setFillColor(colour);
+    circle->setFillColor(lane.colour);
     circle->setOutlineColor(OUTLINE_COLOUR);
     circle->setOutlineThickness(NOTE_OUTLINE_THICKNESS);
 
@@ -118,7 +142,7 @@ GameObject* DrumGameObjectFactory::CreateSongNote(
     // Height is derived by note duration and speed (note should move its
     // entire height over its duration).
     auto y_pos = -padded_radius * 2.0f;
-    auto song_note = new GameObject{ circle, x + padding_px, y_pos
+    auto song_note = new GameObject{ circle, lane.x + padding_px, y_pos
         , padded_radius * 2.0f, padded_radius * 2.0f};
 
     // Add components
@@ -134,7 +158,7 @@ GameObject* DrumGameObjectFactory::CreateSongNote(
 
 GameObject* DrumGameObjectFactory::CreateInstrumentNote(int note) {
     // Create underlying shape
-    double x = GetXPosition(note);
+    const Lane& lane = GetLane(note);
     double y = Config::GetInstance().GetScreenHeight() - (drum_radius_ * 2.0f) -
         (Config::GetInstance().GetScreenHeight() * INSTRUMENT_HOVER_PERCENTAGE);
 
@@ -143,59 +167,80 @@ GameObject* DrumGameObjectFactory::CreateInstrumentNote(int note) {
     sf::CircleShape* circle = new sf::CircleShape{ static_cast<float>(
         padded_radius) };
     circle->setFillColor(INSTRUMENT_FILL_COLOUR);
-    circle->setOutlineColor(DRUM_COLOURS[GetNoteUniqueIndex(note) %
-        NUM_DRUM_COLOURS]);
+    circle->setOutlineColor(lane.colour);
     circle->setOutlineThickness(INSTRUMENT_OUTLINE_THICKNESS);
 
     // Create GameObject
-    auto ins_note = new GameObject{circle, x + padding_px, y
+    auto ins_note = new GameObject{circle, lane.x + padding_px, y
         , padded_radius * 2.0f, padded_radius * 2.0f};
 
-    // Get key binding
-    sf::Keyboard::Key key;
-    bool ctrl, shift;
-    GetInstrumentKeyBinding(note, &key, &ctrl, &shift);
-
     // Add components
     ins_note->SetComponent(new InstrumentComponent{});
     ins_note->SetComponent(new NoteInfoComponent{-1, 9, note
             , Config::GetInstance().GetMidiOutVelocity()});
-    ins_note->SetComponent(new InstrumentInputHandlerComponent{key, ctrl
-            , shift});
+    ins_note->SetComponent(new InstrumentInputHandlerComponent{lane.key
+            , lane.ctrl, lane.shift});
     ins_note->SetComponent(new VerticalCollisionDetectorComponent{});
     ins_note->SetComponent(new InstrumentAutoPlayComponent{
             InstrumentAutoPlayComponent::CollisionCriteria::CENTRE});
     return ins_note;
 }
 
-void DrumGameObjectFactory::GetInstrumentKeyBinding(
-        int midi_key
-        , sf::Keyboard::Key* key
-        , bool* ctrl
-        , bool* shift) {
-    const std::vector<sf::Keyboard::Key>& keys = Utility::GetQwertyKeys();
-    assert(keys.size() >= song_notes_.size());
-
-    // Get the key
-    int idx = GetNoteUniqueIndex(midi_key);
-    *key = keys[idx];
-    *ctrl = false;
-    *shift = false;
+const DrumGameObjectFactory::Lane& DrumGameObjectFactory::GetLane(int note)
+        const {
+    assert(note >= 0 && note < NUM_MIDI_KEYS);
+    assert(lane_index_[note] != NO_LANE);
+    return lanes_[lane_index_[note]];
 }
 
-int DrumGameObjectFactory::GetNoteUniqueIndex(int note) {
-    auto pos = std::find(song_notes_.begin(), song_notes_.end(), note);
-    assert(pos != song_notes_.end());
-    return pos - song_notes_.begin();
-}
-
-double DrumGameObjectFactory::GetXPosition(int note) {
-    return x_pos_offset_ + GetNoteUniqueIndex(note) * (drum_radius_ * 2);
+bool DrumGameObjectFactory::HasSameLayout(const GameObjectFactory& other)
+        const {
+    // There is a drum for each unique note in the song
+    return GameObjectFactory::HasSameLayout(other) && static_cast<const
+        DrumGameObjectFactory&>(other).song_notes_ == song_notes_;
 }
 
 bool DrumGameObjectFactory::Init() {
-    // We have nothing to initialise...
+    // The effect atlas holds a single white circle. Edge pixels are partly
+    // transparent, so the circle is smooth when scaled.
+    sf::Image atlas;
+    atlas.create(EFFECT_FRAME_SIZE, EFFECT_FRAME_SIZE, sf::Color::Transparent);
+    double radius = EFFECT_FRAME_SIZE / 2.0;
+    for (int y = 0; y < EFFECT_FRAME_SIZE; ++y) {
+        for (int x = 0; x < EFFECT_FRAME_SIZE; ++x) {
+            double dist = std::hypot(x + 0.5 - radius, y + 0.5 - radius);
+            double coverage = std::min(1.0, std::max(0.0, radius - dist));
+            atlas.setPixel(x, y, {255, 255, 255, static_cast<sf::Uint8>(
+                        coverage * 255)});
+        }
+    }
+    SetEffectAtlas(atlas, EFFECT_FRAME_SIZE);
     return true;
 }
 
+void DrumGameObjectFactory::InitLanes() {
+    const std::vector<sf::Keyboard::Key>& keys = Utility::GetQwertyKeys();
+    int num_keys = keys.size();
+    std::fill(lane_index_, lane_index_ + NUM_MIDI_KEYS, NO_LANE);
+
+    // Lanes are bound to the QWERTY keys in order. When there are more lanes
+    // than keys, we wrap around and use the keys again with the ctrl modifier,
+    // and then with the shift modifier. Any lanes left over have no key, and
+    // can only be played with a MIDI instrument (or auto play).
+    for (int i = 0; i < static_cast<int>(song_notes_.size()); ++i) {
+        int note = song_notes_[i];
+        assert(note >= 0 && note < NUM_MIDI_KEYS);
+        lane_index_[note] = i;
+
+        Lane lane;
+        lane.colour = DRUM_COLOURS[i % NUM_DRUM_COLOURS];
+        lane.ctrl = i >= num_keys && i < num_keys * 2;
+        lane.key = i < num_keys * 3 ? keys[i % num_keys] :
+            sf::Keyboard::Unknown;
+        lane.shift = i >= num_keys * 2 && i < num_keys * 3;
+        lane.x = x_pos_offset_ + i * (drum_radius_ * 2);
+        lanes_.push_back(lane);
+    }
+}
+
 }  // End namespace midistar
@@ -25,7 +25,7 @@
 #include "midistar/InstrumentInputHandlerComponent.h"
 #include "midistar/MidiNoteComponent.h"
 #include "midistar/NoteInfoComponent.h"
-#include "midistar/OutlineEffectComponent.h"
+#include "midistar/PhysicsComponent.h"
 #include "midistar/ResizeComponent.h"
 #include "midistar/VerticalCollisionDetectorComponent.h"
 
@@ -39,26 +39,36 @@ void DrumSongNoteCollisionHandlerComponent::HandleCollisions(
         Game* g
         , GameObject* o
         , int
-        , std::vector<GameObject*> colliding_with) {
-    // Handle each collision
+        , const VerticalCollisionDetectorComponent& contacts) {
+    // Handle each new collision. An instrument stops being collidable once it
+    // has played a note, so a note can only be hit as an instrument is pressed
+    // or as the note reaches a pressed instrument.
     GameObject* valid_collider = nullptr;
-    for (auto& collider : colliding_with) {
-        if (HandleCollision(g, o, collider)) {
+    double due_time = 0;
+    for (auto& collider : contacts.GetEntered()) {
+        if (HandleCollision(g, o, collider, &due_time)) {
             valid_collider = collider;
         }
     }
 
     // If we are being played, let's add a drum play effect
     if (valid_collider) {
-        auto play_effect = g->GetGameObjectFactory().CreateNotePlayEffect(o);
-        g->AddGameObject(play_effect);
+        EffectSystem::Effect effect;
+        auto& factory = g->GetGameObjectFactory();
+        if (factory.CreateNotePlayEffect(o, &effect)) {
+            auto& effects = g->GetEffectSystem();
+            factory.AnimateNotePlayEffect(&g->GetTweens(), &effects, effects.
+                    Add(effect));
+        }
+        g->RecordNoteHit(valid_collider, due_time);
     }
 }
 
 bool DrumSongNoteCollisionHandlerComponent::HandleCollision(
-        Game*
+        Game* g
         , GameObject* o
-        , GameObject* collider) {
+        , GameObject* collider
+        , double* due_time) {
     // We only want to handle collisions with instruments
     if (!collider->HasComponent(Component::INSTRUMENT)) {
         return false;
@@ -95,6 +105,19 @@ bool DrumSongNoteCollisionHandlerComponent::HandleCollision(
         inst_input_handler->SetNotePlayed(true);
     }
 
+    // The note was due when its bottom reached the top of the instrument.
+    // Notes only move by falling, so we can work out when that was from where
+    // they are now.
+    *due_time = g->GetTimers().GetTime();
+    auto physics = o->GetComponent<PhysicsComponent>(Component::PHYSICS);
+    if (physics) {
+        double x_vel, y_vel;
+        physics->GetVelocity(&x_vel, &y_vel);
+        if (y_vel > 0) {
+            *due_time += (inst_y - (y + height)) / y_vel;
+        }
+    }
+
     // Make the note invisible (it has been played)
     o->SetComponent(new ResizeComponent{0, 0});
     o->DeleteComponent(GetType());
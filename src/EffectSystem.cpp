@@ -0,0 +1,133 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "midistar/EffectSystem.h"
+
+#include <iostream>
+
+namespace midistar {
+
+EffectSystem::EffectSystem()
+        : atlas_{}
+        , atlas_changed_{false}
+        , atlas_image_{}
+        , count_{0}
+        , frame_size_{1}
+        , free_slots_{}
+        , slots_{}
+        , vertices_{sf::Quads} {
+}
+
+int EffectSystem::Add(const Effect& effect) {
+    ++count_;
+    if (!free_slots_.empty()) {
+        int id = free_slots_.back();
+        free_slots_.pop_back();
+        slots_[id] = {effect, 0, true};
+        return id;
+    }
+    slots_.push_back({effect, 0, true});
+    return slots_.size() - 1;
+}
+
+void EffectSystem::Clear() {
+    slots_.clear();
+    free_slots_.clear();
+    count_ = 0;
+}
+
+void EffectSystem::Draw(sf::RenderTarget* target) {
+    GetVertices(&vertices_);
+    if (vertices_.getVertexCount()) {
+        target->draw(vertices_, &GetAtlas());
+    }
+}
+
+const sf::Texture& EffectSystem::GetAtlas() {
+    if (atlas_changed_) {
+        atlas_changed_ = false;
+        if (!atlas_.loadFromImage(atlas_image_)) {
+            std::cerr << "Error: could not create the effect atlas texture!\n";
+        }
+    }
+    return atlas_;
+}
+
+EffectSystem::Effect& EffectSystem::Get(int id) {
+    return slots_[id].effect;
+}
+
+int EffectSystem::GetCount() const {
+    return count_;
+}
+
+void EffectSystem::GetVertices(sf::VertexArray* vertices) const {
+    // Build one quad per effect, so everything is drawn in a single call
+    vertices->setPrimitiveType(sf::Quads);
+    vertices->resize(count_ * 4);
+    std::size_t v = 0;
+    for (const auto& s : slots_) {
+        if (!s.live) {
+            continue;
+        }
+        const auto& e = s.effect;
+        float u = static_cast<float>(e.frame * frame_size_);
+        float t = static_cast<float>(e.row * frame_size_);
+        float size = static_cast<float>(frame_size_);
+
+        (*vertices)[v++] = {{e.x, e.y}, e.colour, {u, t}};
+        (*vertices)[v++] = {{e.x + e.width, e.y}, e.colour, {u + size, t}};
+        (*vertices)[v++] = {{e.x + e.width, e.y + e.height}, e.colour, {u +
+            size, t + size}};
+        (*vertices)[v++] = {{e.x, e.y + e.height}, e.colour, {u, t + size}};
+    }
+}
+
+void EffectSystem::Init(const sf::Image& atlas, int frame_size) {
+    atlas_changed_ = true;
+    atlas_image_ = atlas;
+    frame_size_ = frame_size;
+}
+
+void EffectSystem::Remove(int id) {
+    if (id == NO_EFFECT || !slots_[id].live) {
+        return;
+    }
+    slots_[id].live = false;
+    free_slots_.push_back(id);
+    --count_;
+}
+
+void EffectSystem::Update(int delta) {
+    for (auto& s : slots_) {
+        if (!s.live) {
+            continue;
+        }
+        auto& e = s.effect;
+
+        // Step through the animation frames, wrapping around at the end
+        s.frame_time += delta;
+        if (e.num_frames > 1 && s.frame_time >= e.ms_per_frame) {
+            s.frame_time = 0;
+            e.frame = (e.frame + 1) % e.num_frames;
+        }
+    }
+}
+
+}  // End namespace midistar
@@ -0,0 +1,146 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "midistar/FrameWriter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace midistar {
+
+FrameWriter::FrameWriter()
+        : failed_{false}
+        , frame_count_{0}
+        , jobs_{}
+        , jobs_changed_{}
+        , max_jobs_{0}
+        , mutex_{}
+        , path_{""}
+        , raw_{false}
+        , stopping_{false}
+        , threads_{} {
+}
+
+FrameWriter::~FrameWriter() {
+    Finish();
+}
+
+bool FrameWriter::Finish() {
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+    }
+    jobs_changed_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+    threads_.clear();
+    if (raw_) {
+        std::fflush(stdout);
+    }
+    return !failed_;
+}
+
+int FrameWriter::GetFrameCount() const {
+    return frame_count_;
+}
+
+bool FrameWriter::Init(const std::string& path, int num_threads) {
+    path_ = path;
+    raw_ = path == "-";
+    if (raw_) {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        return true;
+    }
+
+    // PNG compression is the slow part, so it gets the thread pool
+    if (num_threads <= 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    max_jobs_ = num_threads * FRAMES_PER_THREAD;
+    for (int i = 0; i < num_threads; ++i) {
+        threads_.emplace_back(&FrameWriter::EncodeFrames, this);
+    }
+    return true;
+}
+
+bool FrameWriter::Write(const sf::Image& frame) {
+    int number = frame_count_++;
+
+    // Raw frames are cheap to write, and must be written in order
+    if (raw_) {
+        auto size = frame.getSize();
+        std::size_t bytes = size.x * size.y * 4;
+        if (std::fwrite(frame.getPixelsPtr(), 1, bytes, stdout) != bytes) {
+            std::cerr << "Error! Could not write frame " << number
+                << " to standard output.\n";
+            failed_ = true;
+        }
+        return !failed_;
+    }
+
+    // Wait for room in the queue, so we don't hold every frame in memory when
+    // the encoders fall behind
+    std::unique_lock<std::mutex> lock{mutex_};
+    jobs_changed_.wait(lock, [this] { return jobs_.size() < max_jobs_; });
+    jobs_.push_back({number, frame});
+    bool ok = !failed_;
+    lock.unlock();
+    jobs_changed_.notify_all();
+    return ok;
+}
+
+void FrameWriter::EncodeFrames() {
+    while (true) {
+        std::unique_lock<std::mutex> lock{mutex_};
+        jobs_changed_.wait(lock, [this] {
+            return !jobs_.empty() || stopping_;
+        });
+        if (jobs_.empty()) {
+            return;  // Stopping, and nothing left to write
+        }
+        auto job = std::move(jobs_.front());
+        jobs_.pop_front();
+        lock.unlock();
+        jobs_changed_.notify_all();
+
+        if (!job.image.saveToFile(GetFileName(job.number))) {
+            std::lock_guard<std::mutex> failed_lock{mutex_};
+            failed_ = true;
+        }
+    }
+}
+
+std::string FrameWriter::GetFileName(int number) const {
+    std::ostringstream name;
+    name << path_ << std::setw(FRAME_NUMBER_DIGITS) << std::setfill('0')
+        << number << ".png";
+    return name.str();
+}
+
+}  // End namespace midistar
@@ -18,38 +18,142 @@
 
 #include "midistar/Game.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <string>
+#include <thread>
 #include <vector>
 #include <SFML/Graphics.hpp>
 
-#include "midistar/DefaultGameObjectFactory.h"
-#include "midistar/DrumGameObjectFactory.h"
-#include "midistar/PianoGameObjectFactory.h"
 #include "midistar/Config.h"
+#include "midistar/GameModes.h"
+#include "midistar/InstrumentInputHandlerComponent.h"
 #include "midistar/NoteInfoComponent.h"
+#include "midistar/PhysicsComponent.h"
 
 namespace midistar {
 
-Game::Game()
-        : object_factory_{nullptr}
-        , window_{sf::VideoMode(Config::GetInstance().GetScreenWidth()
+Game::Game(bool headless)
+        : component_counters_{}
+        , component_counts_{}
+        , effects_{}
+        , effects_counter_{0}
+        , events_mutex_{}
+        , extra_passes_counter_{0}
+        , first_frame_shown_{false}
+        , headless_{headless}
+        , hit_judge_{}
+        , input_first_{Config::GetInstance().GetInputFirst()}
+        , input_log_{}
+        , input_time_{NO_INPUT}
+        , latency_counter_{0}
+        , object_factory_{nullptr}
+        , midi_dropped_counter_{0}
+        , midi_file_in_{new MidiFileIn{}}
+        , midi_passed_counter_{0}
+        , midi_thru_{Config::GetInstance().GetMidiThru() && !headless &&
+            Config::GetInstance().GetReplayInput().empty()}
+        , next_midi_file_in_{nullptr}
+        , next_note_{0}
+        , next_object_factory_{nullptr}
+        , next_song_{}
+        , note_layer_{}
+        , notes_hit_{0}
+        , playlist_{Config::GetInstance().GetPlaylist()}
+        , polled_events_{}
+        , profiler_{}
+        , render_deadline_{Config::GetInstance().GetRenderDeadline()}
+        , render_target_{nullptr}
+        , record_input_{!Config::GetInstance().GetRecordInput().empty()}
+        , replay_input_{!Config::GetInstance().GetReplayInput().empty()}
+        , resources_mutex_{}
+        , running_{true}
+        , sf_events_clock_{0}
+        , simulation_thread_{false}
+        , snapshots_{}
+        , song_index_{0}
+        , song_time_{0}
+        , sound_font_{}
+        , spawned_{0}
+        , spawned_counter_{0}
+        , startup_clock_{}
+        , state_digest_{FNV_OFFSET_BASIS}
+        , tick_clock_{0}
+        , ticks_{0}
+        , time_{0}
+        , timers_{}
+        , timers_counter_{0}
+        , tweens_{}
+        , tweens_counter_{0}
+        , updates_counter_{0}
+        , window_{}
+        , window_events_{} {
+    if (!headless_) {
+        window_.create(sf::VideoMode(Config::GetInstance().GetScreenWidth()
                  , Config::GetInstance().GetScreenHeight())
                  , "midistar"
                  , Config::GetInstance().GetFullScreen() ?
-                 sf::Style::Fullscreen : sf::Style::Default} {
+                 sf::Style::Fullscreen : sf::Style::Default);
+        render_target_ = &window_;
+    }
+    profiler_.SetEnabled(Config::GetInstance().GetProfile());
+    for (int i = 0; i < Component::NUM_COMPONENTS; ++i) {
+        component_counters_[i] = profiler_.AddCounter(std::string{
+                "components."} + Component::GetTypeName(
+                    static_cast<ComponentType>(i)));
+    }
+    effects_counter_ = profiler_.AddCounter("effects");
+    extra_passes_counter_ = profiler_.AddCounter("spawn.extra_passes");
+    latency_counter_ = profiler_.AddCounter("latency.input_us");
+    midi_dropped_counter_ = profiler_.AddCounter("midi_in.dropped");
+    midi_passed_counter_ = profiler_.AddCounter("midi_in.passed");
+    spawned_counter_ = profiler_.AddCounter("spawn.objects");
+    timers_counter_ = profiler_.AddCounter("timers.pending");
+    tweens_counter_ = profiler_.AddCounter("tweens");
+    updates_counter_ = profiler_.AddCounter("updates.calls");
+}
+
+Game::Game()
+        : Game{false} {
 }
 
 Game::~Game() {
+    // The next song may still be loading
+    if (next_song_.valid()) {
+        next_song_.wait();
+    }
     for (auto& o : objects_) {
         delete o;
     }
+    for (auto& o : new_objects_) {
+        delete o;
+    }
     if (object_factory_) {
         delete object_factory_;
     }
+    if (next_object_factory_) {
+        delete next_object_factory_;
+    }
+    delete midi_file_in_;
+    delete next_midi_file_in_;
 }
 
 void Game::AddGameObject(GameObject* obj) {
-    new_objects_.push(obj);
+    new_objects_.push_back(obj);
+    ++spawned_;
+}
+
+bool Game::FinishAudioRender() {
+    return midi_out_.EndFileRender(time_);
+}
+
+int Game::GetComponentCount(ComponentType type) {
+    return component_counts_[type];
+}
+
+EffectSystem& Game::GetEffectSystem() {
+    return effects_;
 }
 
 GameObjectFactory& Game::GetGameObjectFactory() {
@@ -64,146 +168,315 @@ const std::vector<GameObject*>& Game::GetGameObjects() {
     return objects_;
 }
 
+double Game::GetInputTime(const MidiMessage& msg) {
+    return ClockToTime(msg.GetTime());
+}
+
+double Game::GetInputTime(const sf::Event&) {
+    return ClockToTime(sf_events_clock_);
+}
+
+Profiler& Game::GetProfiler() {
+    return profiler_;
+}
+
 const std::vector<sf::Event>& Game::GetSfEvents() {
     return sf_events_;
 }
 
+TimerWheel& Game::GetTimers() {
+    return timers_;
+}
+
+TweenSystem& Game::GetTweens() {
+    return tweens_;
+}
+
 sf::RenderWindow& Game::GetWindow() {
     return window_;
 }
 
 bool Game::Init() {
-    // Setup SFML window
-    window_.setFramerateLimit(Config::GetInstance().
-            GetMaximumFramesPerSecond());
-    window_.setKeyRepeatEnabled(false);
-
-    // Setup MIDI input / outputs
-    midi_instrument_in_.Init();  // It is okay if this fails (player can be
-                                                    // using computer keyboard)
-    if (!midi_file_in_.Init(Config::GetInstance().GetMidiFileName())) {
+    // Setup SFML window and MIDI input / outputs. Headless games have no
+    // window, and don't need to play or listen to anything.
+    if (!headless_) {
+        window_.setFramerateLimit(Config::GetInstance().
+                GetMaximumFramesPerSecond());
+        window_.setKeyRepeatEnabled(false);
+    }
+    if (replay_input_ && !input_log_.Load(Config::GetInstance().
+                GetReplayInput())) {
         return false;
     }
-    if (!midi_out_.Init()) {
+    if (render_deadline_ && (headless_ || record_input_ || replay_input_)) {
+        std::cerr << "Warning: input is not sampled again before drawing "
+            "while recording or replaying input, or without a window.\n";
+        render_deadline_ = 0;
+    }
+    auto tick_rate = Config::GetInstance().GetTickRate();
+    if (Config::GetInstance().GetSimulationThread() && (tick_rate < 1 ||
+                tick_rate > 1000)) {
+        std::cerr << "Error: the tick rate must be between 1 and 1000.\n";
+        return false;
+    }
+    auto render_audio = Config::GetInstance().GetRenderAudio();
+    if (!render_audio.empty()) {
+        if (!midi_out_.InitFileRenderer(render_audio)) {
+            return false;
+        }
+    } else if (!headless_ && !midi_out_.Init()) {
         return false;
     }
 
-    // Setup GameObject factory and create GameObjects
-    double note_speed = (midi_file_in_.GetTicksPerQuarterNote() /
-        Config::GetInstance().GetMidiFileTicksPerUnitOfSpeed()) *
-        Config::GetInstance().GetFallSpeedMultiplier();
-
-    auto mode = Config::GetInstance().GetGameMode();
-    auto unique_notes = midi_file_in_.GetUniqueMidiNotes();
-
-#ifdef DEBUG
-    std::cout << "MIDI file unique notes: \n";
-    for (const auto& n : unique_notes) {
-        std::cout << n << ' ';
+    // MIDI input starts once MIDI output is ready, as thru notes are played
+    // from the moment the ports are opened
+    if (!headless_) {
+        if (midi_thru_) {
+            midi_instrument_in_.SetThru(&midi_out_);
+        }
+        midi_instrument_in_.Init();  // It is okay if this fails (player can be
+                                                    // using computer keyboard)
     }
-    std::cout << '\n';
-#endif
 
-    if (mode == "drum") {
-        auto max_note_duration = midi_file_in_.GetMaximumNoteDuration();
-        object_factory_ = new DrumGameObjectFactory(note_speed, unique_notes
-            , max_note_duration);
-    } else if (mode == "piano") {
-        object_factory_ = new PianoGameObjectFactory(note_speed);
-    } else {
-        object_factory_ = new DefaultGameObjectFactory(note_speed);
+    // The first MIDI file (followed by the assets that depend on it) and the
+    // SoundFont are loaded in parallel, in the background. Only the MIDI file
+    // and assets are needed to start playing: the first song notes take a
+    // while to reach the instrument, and the SoundFont usually arrives before
+    // them. Offline audio renders need the SoundFont from the first sample.
+    if (playlist_.empty()) {
+        playlist_.push_back(Config::GetInstance().GetMidiFileName());
+    }
+    auto assets = std::async(std::launch::async, [this] {
+        return LoadSong(playlist_[0], midi_file_in_, &object_factory_);
+    }).share();
+    bool sound_font_needed = !render_audio.empty();
+    if (sound_font_needed || !headless_) {
+        sound_font_ = std::async(std::launch::async, [this] {
+            if (!midi_out_.LoadSoundFont()) {
+                return false;
+            }
+            midi_out_.PinPresets(headless_ ? &std::cerr : &std::cout);
+            return true;
+        });
     }
-    if (!object_factory_->Init()) {
+    while (!IsReady(assets) || (sound_font_needed && !IsReady(sound_font_))) {
+        if (!ShowLoadingScreen(IsReady(assets) + (sound_font_.valid() &&
+                        IsReady(sound_font_)), 1 + sound_font_.valid())) {
+            return false;
+        }
+    }
+    if (!assets.get() || (sound_font_needed && !CheckSoundFont())) {
         return false;
     }
 
-    auto instrument = object_factory_->CreateInstrument();
-    objects_.insert(objects_.end(), instrument.begin(), instrument.end());
+    effects_.Init(object_factory_->GetEffectAtlas(), object_factory_->
+            GetEffectFrameSize());
+    for (auto o : object_factory_->CreateInstrument()) {
+        InsertObject(o);
+    }
+    InitMidiThru();
+    InitNoteLayer(&note_layer_);
+    if (!headless_) {
+        std::cout << "Startup: playable after " << startup_clock_.
+            getElapsedTime().asMilliseconds() << "ms.\n";
+    }
+    PrepareNextSong();
     return true;
 }
 
-void Game::Run() {
-    unsigned int t = 0;
-    sf::Clock clock;
-    while (window_.isOpen()) {
-        // Clean up from last tick
-        FlushNewObjectQueue();
-        window_.clear(object_factory_->GetBackgroundColour());
-        int delta = clock.getElapsedTime().asMilliseconds();
-        clock.restart();
-
-        // Handle updating
-        unsigned num_objects;
-        unsigned i = 0;
-        do {
-            num_objects = objects_.size();
-            while (i < objects_.size()) {
-                objects_[i++]->Update(this, delta);
-            }
-            FlushNewObjectQueue();
-        // If we've added new objects during updating, we will update them now.
-        // NOTE: This could cause an infinite loop if new objects create new
-        // objects.
-        } while (num_objects != objects_.size());
+bool Game::IsMidiThru() {
+    return midi_thru_;
+}
 
-        // Handle drawing
-        for (auto obj : objects_) {
-            obj->Draw(&window_);
-        }
-        window_.display();
+bool Game::IsRunning() {
+    return running_;
+}
 
-        // Handle MIDI file events
-        MidiMessage msg;
-        while (midi_file_in_.GetMessage(&msg)) {
-            if (msg.IsNoteOn()) {
-                objects_.push_back(object_factory_->
-                        CreateSongNote(
-                            msg.GetTrack()
-                            , msg.GetChannel()
-                            , msg.GetKey()
-                            , msg.GetVelocity()
-                            , msg.GetDuration()));
+void Game::RecordNoteHit(GameObject* instrument, double due_time) {
+    ++notes_hit_;
+
+    // Each press is only judged once, so a key held through several notes
+    // doesn't judge them all against the same press
+    auto handler = instrument->GetComponent<InstrumentInputHandlerComponent>(
+            Component::INSTRUMENT_INPUT_HANDLER);
+    double press_time;
+    if (handler && handler->TakePressTime(&press_time)) {
+        hit_judge_.AddHit(press_time - due_time);
+    }
+}
+
+void Game::RemoveEffect(int effect) {
+    tweens_.Remove(&effects_, effect);
+    effects_.Remove(effect);
+}
+
+void Game::Run() {
+    if (Config::GetInstance().GetSimulationThread() && !headless_) {
+        RunSimulationThread();
+    } else {
+        sf::Clock clock;
+        while (running_) {
+            int delta = clock.restart().asMilliseconds();
+
+            // When replaying, we use the recorded clock instead of the real
+            // one. The replay ends where the recording ended.
+            if (replay_input_ && !input_log_.GetNextTick(&delta)) {
+                Stop();
+                break;
             }
+            Tick(delta);
         }
+    }
 
-        // Handle MIDI port input events
-        midi_in_buf_.clear();
-        while (midi_instrument_in_.GetMessage(&msg)) {
-#ifdef DEBUG
-            if (msg.IsNoteOn()) {
-                std::cout << "Played: " << msg.GetKey() << '\n';
-            }
-#endif
+    if (record_input_) {
+        input_log_.Save(Config::GetInstance().GetRecordInput());
+    }
+    if (record_input_ || replay_input_) {
+        WriteSessionSummary(&std::cout);
+    }
+    if (profiler_.IsEnabled()) {
+        profiler_.WriteReport(&std::cout);
+    }
+    if (hit_judge_.GetNumHits()) {
+        hit_judge_.WriteReport(&std::cout);
+    }
+}
 
-            midi_in_buf_.push_back(msg);
+void Game::SetRenderTarget(sf::RenderTarget* target) {
+    render_target_ = target;
+}
+
+void Game::Stop() {
+    running_ = false;
+
+    // Only the window thread may close the window
+    if (!simulation_thread_) {
+        window_.close();
+    }
+}
+
+void Game::Tick(int delta) {
+    profiler_.BeginFrame();
+    auto tick_start = startup_clock_.getElapsedTime().asMicroseconds();
+    tick_clock_ = MidiPortIn::GetClockTime();
+    time_ += delta;
+    song_time_ += delta;
+
+    // When rendering audio offline, notes played this tick start at this time
+    if (!midi_out_.Render(time_)) {
+        Stop();
+    }
+
+    // The SoundFont may still be loading in the background
+    if (!CheckSoundFont()) {
+        Stop();
+    }
+    if (record_input_) {
+        input_log_.AddTick(delta);
+    }
+
+    // Clean up from last tick
+    FlushNewObjectQueue();
+    if (render_target_) {
+        render_target_->clear(object_factory_->GetBackgroundColour());
+    }
+
+    // When input is handled first, it is seen by this tick's updates rather
+    // than the next one's. Song notes spawned now are moved by this tick's
+    // update, so they are placed where they were a tick ago.
+    if (input_first_) {
+        PollInput();
+        SpawnSongNotes(song_time_, song_time_ - delta);
+    }
+
+    // Handle updating. Timers that are due go first, so their changes are
+    // seen by this tick's updates.
+    timers_.Advance(delta);
+    spawned_ = 0;
+    int num_updates = 0;
+    auto num_objects = objects_.size();
+    for (std::size_t i = 0; i < num_objects; ++i) {
+        num_updates += objects_[i]->Update(this, delta);
+    }
+
+    // Objects spawned while updating are committed and updated in extra
+    // passes, so they are drawn this frame. Objects that spawn objects could
+    // keep this going forever, so the number of passes is limited. Anything
+    // still staged gets its first update next tick.
+    int extra_passes = 0;
+    while (!new_objects_.empty() && extra_passes < Config::GetInstance().
+            GetMaximumSpawnPasses()) {
+        auto first = objects_.size();
+        FlushNewObjectQueue();
+        for (auto i = first; i < objects_.size(); ++i) {
+            num_updates += objects_[i]->Update(this, delta);
         }
+        ++extra_passes;
+    }
+    effects_.Update(delta);
+    tweens_.Update(delta);
+    if (render_deadline_) {
+        LatchInput(tick_start);
+    }
 
-        // Handle SFML events
-        sf_events_.clear();
-        sf::Event event;
-        while (window_.pollEvent(event)) {
-            sf_events_.push_back(event);
-            if (event.type == sf::Event::Closed
-                || (event.type == sf::Event::KeyPressed &&
-                        event.key.code == sf::Keyboard::Escape)) {
-                window_.close();
-            }
+    // Handle drawing
+    if (render_target_) {
+        note_layer_.Draw(render_target_, next_note_, song_time_);
+        for (auto obj : objects_) {
+            obj->Draw(render_target_);
         }
+        effects_.Draw(render_target_);
+    }
+    if (!headless_ && !simulation_thread_) {
+        window_.display();
+    }
 
-        // Update MIDI file and port
-        midi_file_in_.Tick(delta);
-        midi_instrument_in_.Tick();
+    // Input has been drawn once it has been updated, so this is as close to
+    // the input reaching the screen as we can measure
+    if (input_time_ != NO_INPUT) {
+        profiler_.SetCounter(latency_counter_, startup_clock_.getElapsedTime()
+                .asMicroseconds() - input_time_);
+        input_time_ = NO_INPUT;
+    }
+    if (!input_first_) {
+        SpawnSongNotes(song_time_, song_time_);
+        PollInput();
+    }
 
-        // Clean up!
-        CleanUpObjects();
+    // Clean up!
+    CleanUpObjects();
 
-        // If we're done playing the file and have no song notes to be played,
-        // we're done!
-        if (midi_file_in_.IsEof() && !CheckSongNotes()) {
-            window_.close();
+    // If we're done playing the file and have no song notes to be played,
+    // we move on to the next song. After the last song, we're done!
+    if (next_note_ >= midi_file_in_->GetNoteSchedule().size() &&
+            !CheckSongNotes() && !StartNextSong()) {
+        Stop();
+    }
+
+    if (profiler_.IsEnabled()) {
+        UpdateCounters();
+        profiler_.SetCounter(effects_counter_, effects_.GetCount());
+        profiler_.SetCounter(extra_passes_counter_, extra_passes);
+        profiler_.SetCounter(midi_dropped_counter_, midi_instrument_in_.
+                GetFilter().GetDropped());
+        profiler_.SetCounter(midi_passed_counter_, midi_instrument_in_.
+                GetFilter().GetPassed());
+        profiler_.SetCounter(spawned_counter_, spawned_);
+        profiler_.SetCounter(timers_counter_, timers_.GetCount());
+        profiler_.SetCounter(tweens_counter_, tweens_.GetCount());
+        profiler_.SetCounter(updates_counter_, num_updates);
+        profiler_.EndFrame(objects_.size(), CountSongNotes());
+    }
+
+    // Hash the state of this tick, so sessions can be compared across builds
+    if (record_input_ || replay_input_) {
+        for (std::uint64_t v : {static_cast<std::uint64_t>(objects_.size())
+                , static_cast<std::uint64_t>(CountSongNotes())
+                , static_cast<std::uint64_t>(notes_hit_)}) {
+            state_digest_ = (state_digest_ ^ v) * FNV_PRIME;
         }
-        ++t;
     }
+    ++ticks_;
 }
 
 void Game::TurnMidiNoteOff(int chan, int note) {
@@ -214,15 +487,55 @@ void Game::TurnMidiNoteOn(int chan, int note, int vel) {
     midi_out_.SendNoteOn(note, chan, vel);
 }
 
+void Game::CaptureSnapshot(RenderSnapshot* snapshot) {
+    snapshot->Clear(object_factory_->GetBackgroundColour());
+    if (note_layer_.IsActive()) {
+        snapshot->SetNoteLayer(&note_layer_, next_note_, song_time_);
+    }
+    for (auto obj : objects_) {
+        snapshot->AddObject(obj);
+    }
+    snapshot->AddEffects(&effects_);
+}
+
 bool Game::CheckSongNotes() {
-    for (const auto& obj : objects_) {
-        if (obj->HasComponent(Component::SONG_NOTE)) {
+    if (component_counts_[Component::SONG_NOTE] > 0) {
+        return true;
+    }
+
+    // Song notes can still be staged if the spawn passes ran out this tick
+    for (auto o : new_objects_) {
+        if (o->HasComponent(Component::SONG_NOTE)) {
             return true;
         }
     }
     return false;
 }
 
+double Game::ClockToTime(double clock_time) {
+    // Simulation time is advanced by the real time since the last tick, so
+    // the time this tick started lines up with the current simulation time.
+    // Replayed input has no real arrival time.
+    if (headless_ || replay_input_) {
+        return time_;
+    }
+    return time_ + (clock_time - tick_clock_) * 1000;
+}
+
+bool Game::CheckSoundFont() {
+    if (!sound_font_.valid() || !IsReady(sound_font_)) {
+        return true;
+    }
+    if (!sound_font_.get()) {
+        return false;
+    }
+    if (!headless_) {
+        std::cout << "Startup: SoundFont loaded after " << startup_clock_.
+            getElapsedTime().asMilliseconds() << "ms.\n";
+    }
+    return true;
+}
+
 void Game::CleanUpObjects() {
     auto objects_copy {objects_};
     for (auto& o : objects_copy) {
@@ -232,7 +545,273 @@ void Game::CleanUpObjects() {
     }
 }
 
+int Game::CountSongNotes() {
+    return component_counts_[Component::SONG_NOTE];
+}
+
+void Game::InitMidiThru() {
+    if (!midi_thru_) {
+        return;
+    }
+    for (auto o : objects_) {
+        auto note = o->GetComponent<NoteInfoComponent>(Component::NOTE_INFO);
+        if (o->HasComponent(Component::INSTRUMENT) && note) {
+            midi_instrument_in_.SetThruChannel(note->GetChannel());
+            return;
+        }
+    }
+}
+
+void Game::InitNoteLayer(NoteLayer* layer) {
+    if (!Config::GetInstance().GetNoteBuffer()) {
+        return;
+    }
+
+    // Notes are activated before they can reach the instrument
+    double activation_y = Config::GetInstance().GetScreenHeight();
+    for (auto o : objects_) {
+        if (o->HasComponent(Component::INSTRUMENT)) {
+            double x, y;
+            o->GetPosition(&x, &y);
+            activation_y = std::min(activation_y, y);
+        }
+    }
+    if (!layer->Init(midi_file_in_->GetNoteSchedule(), object_factory_
+                , activation_y)) {
+        std::cerr << "Warning: the note buffer does not support this game "
+            "mode. Song notes are drawn as GameObjects instead.\n";
+    }
+}
+
+template <typename T>
+bool Game::IsReady(const T& f) {
+    return f.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+}
+
+bool Game::IsQuitEvent(const sf::Event& e) {
+    return e.type == sf::Event::Closed || (e.type == sf::Event::KeyPressed
+            && e.key.code == sf::Keyboard::Escape);
+}
+
+void Game::LatchInput(sf::Int64 tick_start) {
+    // Input that arrives while waiting for the deadline is handled before
+    // drawing. Only input handlers, and the Components they add to play a
+    // note, are updated again, so nothing else moves twice in a tick.
+    auto wait = tick_start + render_deadline_ * 1000 - startup_clock_.
+        getElapsedTime().asMicroseconds();
+    if (wait > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds{wait});
+    }
+    PollInput();
+    if (midi_in_buf_.empty() && sf_events_.empty()) {
+        return;
+    }
+    for (auto obj : objects_) {
+        if (obj->HasComponent(Component::INSTRUMENT_INPUT_HANDLER)) {
+            obj->Update(this, 0, LATCHED_COMPONENTS);
+        }
+    }
+}
+
+bool Game::LoadSong(const std::string& file_name, MidiFileIn* file
+        , GameObjectFactory** factory) {
+    if (!file->Init(file_name)) {
+        return false;
+    }
+
+    // Setup GameObject factory
+    double note_speed = (file->GetTicksPerQuarterNote() /
+        Config::GetInstance().GetMidiFileTicksPerUnitOfSpeed()) *
+        Config::GetInstance().GetFallSpeedMultiplier();
+
+    auto mode = Config::GetInstance().GetGameMode();
+
+#ifdef DEBUG
+    std::cerr << "MIDI file unique notes: \n";
+    for (const auto& n : file->GetUniqueMidiNotes()) {
+        std::cerr << n << ' ';
+    }
+    std::cerr << '\n';
+#endif
+
+    if (!AllGameModes::IsGameMode(mode)) {
+        std::cerr << "Warning: unknown game mode \"" << mode << "\". Using "
+            "the default game mode.\n";
+    }
+    *factory = AllGameModes::Create(mode, note_speed, *file);
+    return (*factory)->Init();
+}
+
+void Game::PollInput() {
+    // Input first ticks read the MIDI port before taking its messages, so
+    // messages that arrived during the last tick are not held for another
+    if (input_first_) {
+        midi_instrument_in_.Tick();
+    }
+
+    // Handle MIDI port input events
+    MidiMessage msg;
+    midi_in_buf_.clear();
+    sf_events_.clear();
+    while (midi_instrument_in_.GetMessage(&msg)) {
+#ifdef DEBUG
+        if (msg.IsNoteOn()) {
+            std::cout << "Played: " << msg.GetKey() << '\n';
+        }
+#endif
+
+        // Live input is ignored while replaying
+        if (!replay_input_) {
+            midi_in_buf_.push_back(msg);
+        }
+    }
+
+    // Handle SFML events, which the window thread polls if it has its own.
+    // While replaying, window events can only close the game.
+    polled_events_.clear();
+    if (simulation_thread_) {
+        std::lock_guard<std::mutex> lock{events_mutex_};
+        polled_events_.swap(window_events_);
+    } else {
+        sf::Event event;
+        while (window_.pollEvent(event)) {
+            polled_events_.push_back(event);
+        }
+    }
+    sf_events_clock_ = MidiPortIn::GetClockTime();
+    for (const auto& e : polled_events_) {
+        if (!replay_input_) {
+            sf_events_.push_back(e);
+        } else if (IsQuitEvent(e)) {
+            Stop();
+        }
+    }
+    if (replay_input_) {
+        input_log_.GetInput(ticks_, &sf_events_, &midi_in_buf_);
+    }
+    for (const auto& e : sf_events_) {
+        if (IsQuitEvent(e)) {
+            Stop();
+        }
+    }
+
+    // Record input with the tick it reached us in
+    if (record_input_) {
+        for (const auto& m : midi_in_buf_) {
+            input_log_.AddMidiMessage(ticks_, m);
+        }
+        for (const auto& e : sf_events_) {
+            input_log_.AddSfEvent(ticks_, e);
+        }
+    }
+
+    // Update MIDI port
+    if (!input_first_) {
+        midi_instrument_in_.Tick();
+    }
+
+    // Latency is measured from when input is first taken
+    if (input_time_ == NO_INPUT && (!midi_in_buf_.empty() || !sf_events_.
+                empty())) {
+        input_time_ = startup_clock_.getElapsedTime().asMicroseconds();
+    }
+}
+
+void Game::PrepareNextSong() {
+    if (song_index_ + 1 >= playlist_.size()) {
+        return;
+    }
+    next_midi_file_in_ = new MidiFileIn{};
+    next_song_ = std::async(std::launch::async, [this] {
+        return LoadSong(playlist_[song_index_ + 1], next_midi_file_in_
+                , &next_object_factory_);
+    });
+}
+
+void Game::RunSimulationThread() {
+    // SFML windows can only be polled and drawn to on the thread that created
+    // them, so the window stays on this thread and the simulation moves. The
+    // latest snapshot is acquired while holding the resources lock, so it is
+    // never older than the NoteLayer and effect atlas it refers to.
+    simulation_thread_ = true;
+    render_target_ = nullptr;
+    std::thread simulation{[this] { Simulate(); }};
+    while (running_) {
+        sf::Event event;
+        {
+            std::lock_guard<std::mutex> lock{events_mutex_};
+            while (window_.pollEvent(event)) {
+                window_events_.push_back(event);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock{resources_mutex_};
+            snapshots_.Acquire().Draw(&window_);
+        }
+        window_.display();
+    }
+    simulation.join();
+    window_.close();
+}
+
+bool Game::ShowLoadingScreen(int num_loaded, int num_loading) {
+    // The window thread keeps drawing the last snapshot while the simulation
+    // thread waits, but quit events are still seen here
+    if (simulation_thread_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{
+                LOADING_POLL_TIME});
+        std::lock_guard<std::mutex> lock{events_mutex_};
+        for (const auto& e : window_events_) {
+            if (IsQuitEvent(e)) {
+                Stop();
+                return false;
+            }
+        }
+        return true;
+    }
+    if (headless_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{
+                LOADING_POLL_TIME});
+        return true;
+    }
+
+    sf::Event event;
+    while (window_.pollEvent(event)) {
+        if (IsQuitEvent(event)) {
+            Stop();
+            return false;
+        }
+    }
+
+    // Draw a progress bar in the middle of the screen
+    auto size = window_.getSize();
+    sf::Vector2f bar_size{size.x * LOADING_BAR_WIDTH, LOADING_BAR_HEIGHT};
+    sf::Vector2f bar_pos{(size.x - bar_size.x) / 2.0f, (size.y - bar_size.y)
+        / 2.0f};
+    sf::RectangleShape outline{bar_size};
+    outline.setPosition(bar_pos);
+    outline.setFillColor(sf::Color::Transparent);
+    outline.setOutlineColor(sf::Color::White);
+    outline.setOutlineThickness(LOADING_BAR_OUTLINE_THICKNESS);
+    sf::RectangleShape fill{{bar_size.x * num_loaded / num_loading
+        , bar_size.y}};
+    fill.setPosition(bar_pos);
+    fill.setFillColor(sf::Color::White);
+
+    window_.clear(sf::Color::Black);
+    window_.draw(outline);
+    window_.draw(fill);
+    window_.display();
+    if (!first_frame_shown_) {
+        first_frame_shown_ = true;
+        std::cout << "Startup: first frame after " << startup_clock_.
+            getElapsedTime().asMilliseconds() << "ms.\n";
+    }
+    return true;
+}
+
 void Game::DeleteObject(GameObject* o) {
+    tweens_.Remove(o);
     auto itr = std::find(objects_.begin(), objects_.end(), o);
     if (itr != objects_.end()) {
         objects_.erase(itr);
@@ -241,10 +820,153 @@ void Game::DeleteObject(GameObject* o) {
 }
 
 void Game::FlushNewObjectQueue() {
-    while (!new_objects_.empty()) {
-        objects_.push_back(new_objects_.front());
-        new_objects_.pop();
+    objects_.reserve(objects_.size() + new_objects_.size());
+    for (auto o : new_objects_) {
+        InsertObject(o);
     }
+    new_objects_.clear();
+}
+
+void Game::InsertObject(GameObject* o) {
+    objects_.push_back(o);
+    o->SetComponentCounts(component_counts_);
+}
+
+void Game::Simulate() {
+    // Ticks are spread evenly over each second, so their lengths only differ
+    // by a millisecond when the tick rate does not divide a second. Each tick
+    // waits until its time has passed. If the simulation falls behind, it
+    // ticks without waiting until it catches up.
+    std::int64_t rate = Config::GetInstance().GetTickRate();
+    auto start = std::chrono::steady_clock::now();
+    std::int64_t elapsed = 0;
+    for (std::int64_t i = 0; running_; ++i) {
+        int delta = static_cast<int>((i + 1) * 1000 / rate - i * 1000 / rate);
+        if (replay_input_ && !input_log_.GetNextTick(&delta)) {
+            Stop();
+            break;
+        }
+        elapsed += delta;
+        std::this_thread::sleep_until(start + std::chrono::milliseconds{
+                elapsed});
+        Tick(delta);
+        CaptureSnapshot(&snapshots_.GetBack());
+        snapshots_.Publish();
+    }
+}
+
+void Game::SpawnSongNotes(int due_until, int place_at) {
+    // Notes are placed where they would be at place_at had they spawned
+    // exactly on time, so they are in the right place however long the tick
+    // was. The two times differ when notes spawn before this tick's update,
+    // which then moves them on to due_until. When the NoteLayer is active,
+    // it draws notes until they reach its activation line, so they are only
+    // spawned then.
+    const auto& schedule = midi_file_in_->GetNoteSchedule();
+    while (next_note_ < schedule.size() && (note_layer_.IsActive() ?
+                note_layer_.GetActivationTime(next_note_) :
+                schedule[next_note_].time) <= due_until) {
+        const auto& n = schedule[next_note_++];
+        auto note = object_factory_->CreateSongNote(n.track, n.channel, n.key
+                , n.velocity, n.duration);
+        auto physics = note->GetComponent<PhysicsComponent>(
+                Component::PHYSICS);
+        if (physics) {
+            physics->Advance(note, place_at - n.time);
+        }
+        InsertObject(note);
+    }
+
+    // If MIDI file repeat is enabled, start again once every note has spawned
+    if (next_note_ >= schedule.size() && Config::GetInstance().
+            GetMidiFileRepeat()) {
+        next_note_ = 0;
+        song_time_ = 0;
+    }
+}
+
+bool Game::StartNextSong() {
+    if (!next_song_.valid()) {
+        return false;
+    }
+
+    // The next song has usually loaded long before the current one ends
+    while (!IsReady(next_song_)) {
+        if (!ShowLoadingScreen(0, 1)) {
+            return false;
+        }
+    }
+    if (!next_song_.get()) {
+        return false;
+    }
+
+    delete midi_file_in_;
+    midi_file_in_ = next_midi_file_in_;
+    next_midi_file_in_ = nullptr;
+
+    // The instrument is kept if the new song plays on the same one.
+    // Otherwise, it is rebuilt along with everything else on screen.
+    bool same_layout = next_object_factory_->HasSameLayout(*object_factory_);
+    if (!same_layout) {
+        FlushNewObjectQueue();
+        auto objects_copy {objects_};
+        for (auto& o : objects_copy) {
+            DeleteObject(o);
+        }
+        tweens_.Clear();
+        effects_.Clear();
+    }
+    delete object_factory_;
+    object_factory_ = next_object_factory_;
+    next_object_factory_ = nullptr;
+    if (!same_layout) {
+        for (auto o : object_factory_->CreateInstrument()) {
+            InsertObject(o);
+        }
+        InitMidiThru();
+    }
+
+    ++song_index_;
+    next_note_ = 0;
+    song_time_ = 0;
+    NoteLayer note_layer;
+    InitNoteLayer(&note_layer);
+
+    // Snapshots drawn by the window thread refer to the effect atlas and the
+    // NoteLayer, so they are not drawn while those are replaced. Only the
+    // finished data is swapped in here; the window thread uploads it to the
+    // GPU when it draws. A snapshot of the new song is published before they
+    // can be drawn again.
+    {
+        std::lock_guard<std::mutex> lock{resources_mutex_};
+        if (!same_layout) {
+            effects_.Init(object_factory_->GetEffectAtlas(), object_factory_->
+                    GetEffectFrameSize());
+        }
+        note_layer_.Take(&note_layer);
+        if (simulation_thread_) {
+            CaptureSnapshot(&snapshots_.GetBack());
+            snapshots_.Publish();
+        }
+    }
+    if (!headless_) {
+        std::cout << "Playing \"" << playlist_[song_index_] << "\".\n";
+    }
+    PrepareNextSong();
+    return true;
+}
+
+void Game::UpdateCounters() {
+    for (int i = 0; i < Component::NUM_COMPONENTS; ++i) {
+        profiler_.SetCounter(component_counters_[i], component_counts_[i]);
+    }
+}
+
+void Game::WriteSessionSummary(std::ostream* out) {
+    *out << "Session summary: ticks: " << ticks_ << ", time: " << time_
+        << "ms, objects: " << objects_.size() << ", notes hit: " << notes_hit_
+        << ", state digest: " << std::hex << state_digest_ << std::dec
+        << '\n';
 }
 
 }   // namespace midistar
@@ -20,7 +20,11 @@
 
 namespace midistar {
 
+static_assert(Component::NUM_COMPONENTS <= 32, "Component masks must hold a "
+        "bit for each ComponentType");
+
 GameObject::~GameObject() {
+    SetComponentCounts(nullptr);
     for (auto c : components_) {
         delete c;
     }
@@ -33,10 +37,15 @@ void GameObject::DeleteComponent(ComponentType type) {
     }
     to_delete_.push_back(components_[type]);
     components_[type] = nullptr;
+    awake_mask_ &= ~(1u << type);
+    component_mask_ &= ~(1u << type);
+    if (component_counts_) {
+        --component_counts_[type];
+    }
 }
 
-void GameObject::Draw(sf::RenderWindow* window) {
-    window->draw(*drawable_);
+void GameObject::Draw(sf::RenderTarget* target) {
+    target->draw(*drawable_);
 }
 
 void GameObject::GetPosition(double* x, double* y) {
@@ -71,6 +80,26 @@ bool GameObject::HasComponent(ComponentType type) {
 void GameObject::SetComponent(Component* c) {
     DeleteComponent(c->GetType());
     components_[c->GetType()] = c;
+    component_mask_ |= 1u << c->GetType();
+    Wake(c->GetType());
+    if (component_counts_) {
+        ++component_counts_[c->GetType()];
+    }
+}
+
+void GameObject::SetComponentCounts(int* counts) {
+    for (int i = 0; i < Component::NUM_COMPONENTS; ++i) {
+        if (!components_[i]) {
+            continue;
+        }
+        if (component_counts_) {
+            --component_counts_[i];
+        }
+        if (counts) {
+            ++counts[i];
+        }
+    }
+    component_counts_ = counts;
 }
 
 void GameObject::SetPosition(double x, double y) {
@@ -92,13 +121,24 @@ void GameObject::SetSize(double w, double h) {
     }
 }
 
-void GameObject::Update(Game* g, int delta) {
-    auto has_component = false;
-    for (const auto& c : components_) {
-        if (c) {
-            c->Update(g, this, delta);
-            has_component = true;
-        }
+void GameObject::Sleep(ComponentType type) {
+    awake_mask_ &= ~(1u << type);
+}
+
+int GameObject::Update(Game* g, int delta) {
+    return Update(g, delta, ~0u);
+}
+
+int GameObject::Update(Game* g, int delta, std::uint32_t types) {
+    // Components may add, remove, wake or put to sleep other Components, so
+    // the next awake Component is looked up after each update
+    auto has_component = component_mask_ != 0;
+    int num_updated = 0;
+    for (int type = NextAwakeComponent(0, types); type <
+            Component::NUM_COMPONENTS; type = NextAwakeComponent(type + 1
+                , types)) {
+        components_[type]->Update(g, this, delta);
+        ++num_updated;
     }
 
     // If we don't have any components, delete the GameObject
@@ -110,6 +150,30 @@ void GameObject::Update(Game* g, int delta) {
         delete c;
     }
     to_delete_.clear();
+    return num_updated;
+}
+
+void GameObject::Wake(ComponentType type) {
+    if (components_[type] && Component::IsUpdated(type)) {
+        awake_mask_ |= 1u << type;
+    }
+}
+
+int GameObject::NextAwakeComponent(int type, std::uint32_t types) {
+    std::uint32_t mask = type < Component::NUM_COMPONENTS ? (awake_mask_ &
+            types) >> type : 0;
+    if (!mask) {
+        return Component::NUM_COMPONENTS;
+    }
+#ifdef __GNUC__
+    return type + __builtin_ctz(mask);
+#else
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++type;
+    }
+    return type;
+#endif
 }
 
 }   // End namespace midistar
@@ -18,21 +18,50 @@
 
 #include "midistar/GameObjectFactory.h"
 
+#include <typeinfo>
+
 namespace midistar {
 
 GameObjectFactory::GameObjectFactory(
     double note_speed
     , const sf::Color& background_colour)
         : background_colour_{background_colour}
+        , effect_atlas_{}
+        , effect_frame_size_{1}
         , note_speed_{note_speed} {
+    // Factories without effects use a blank atlas
+    effect_atlas_.create(1, 1, sf::Color::White);
+}
+
+void GameObjectFactory::AnimateNotePlayEffect(TweenSystem*, EffectSystem*
+        , int) {
 }
 
 const sf::Color& GameObjectFactory::GetBackgroundColour() {
     return background_colour_;
 }
 
+const sf::Image& GameObjectFactory::GetEffectAtlas() {
+    return effect_atlas_;
+}
+
+int GameObjectFactory::GetEffectFrameSize() {
+    return effect_frame_size_;
+}
+
+bool GameObjectFactory::HasSameLayout(const GameObjectFactory& other) const {
+    // By default, the instrument only depends on the type of factory
+    return typeid(*this) == typeid(other);
+}
+
 double GameObjectFactory::GetNoteSpeed() {
     return note_speed_;
 }
 
+void GameObjectFactory::SetEffectAtlas(const sf::Image& atlas, int
+        frame_size) {
+    effect_atlas_ = atlas;
+    effect_frame_size_ = frame_size;
+}
+
 }  // End namespace midistar
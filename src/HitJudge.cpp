@@ -0,0 +1,92 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midistar/HitJudge.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace midistar {
+
+HitJudge::HitJudge()
+        : buckets_{}
+        , num_hits_{0}
+        , total_{0}
+        , total_abs_{0}
+        , too_early_{0}
+        , too_late_{0} {
+}
+
+void HitJudge::AddHit(double offset) {
+    ++num_hits_;
+    total_ += offset;
+    total_abs_ += std::abs(offset);
+
+    int bucket = static_cast<int>(std::floor((offset + WINDOW) /
+                BUCKET_WIDTH));
+    if (bucket < 0) {
+        ++too_early_;
+    } else if (bucket >= NUM_BUCKETS) {
+        ++too_late_;
+    } else {
+        ++buckets_[bucket];
+    }
+}
+
+int HitJudge::GetNumHits() const {
+    return num_hits_;
+}
+
+void HitJudge::Reset() {
+    std::fill(buckets_, buckets_ + NUM_BUCKETS, 0);
+    num_hits_ = 0;
+    total_ = 0;
+    total_abs_ = 0;
+    too_early_ = 0;
+    too_late_ = 0;
+}
+
+void HitJudge::WriteReport(std::ostream* out) const {
+    if (!num_hits_) {
+        *out << "No hits judged.\n";
+        return;
+    }
+
+    *out << "Hit timing: hits: " << num_hits_ << ", mean offset: "
+        << total_ / num_hits_ << "ms, mean error: " << total_abs_ / num_hits_
+        << "ms (negative offsets are early)\n";
+
+    // Each row is a bucket of offsets, with a bar scaled to the fullest one
+    int most = std::max(std::max(too_early_, too_late_), *std::max_element(
+                buckets_, buckets_ + NUM_BUCKETS));
+    auto write_row = [out, most](const std::string& range, int hits) {
+        *out << range << '\t' << hits << '\t' << std::string(hits *
+                MAX_BAR_LENGTH / most, '#') << '\n';
+    };
+    *out << "offset_ms\thits\n";
+    write_row("<" + std::to_string(-WINDOW), too_early_);
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        int start = i * BUCKET_WIDTH - WINDOW;
+        write_row(std::to_string(start) + ".." + std::to_string(start +
+                    BUCKET_WIDTH - 1), buckets_[i]);
+    }
+    write_row(">=" + std::to_string(WINDOW), too_late_);
+}
+
+}  // End namespace midistar
@@ -0,0 +1,173 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midistar/InputLog.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace midistar {
+
+InputLog::InputLog()
+        : entries_{}
+        , entry_index_{0}
+        , ticks_{}
+        , tick_index_{0} {
+}
+
+void InputLog::AddMidiMessage(int tick, const MidiMessage& msg) {
+    Entry entry;
+    entry.tick = tick;
+    entry.is_midi = true;
+    entry.data = msg.GetData();
+    entry.stamp = msg.GetTime();
+    entries_.push_back(entry);
+}
+
+void InputLog::AddSfEvent(int tick, const sf::Event& event) {
+    Entry entry;
+    entry.tick = tick;
+    entry.is_midi = false;
+    entry.event = event;
+    entry.stamp = 0;
+    entries_.push_back(entry);
+}
+
+void InputLog::AddTick(int delta) {
+    ticks_.push_back(delta);
+}
+
+void InputLog::GetInput(
+        int tick
+        , std::vector<sf::Event>* events
+        , std::vector<MidiMessage>* messages) {
+    while (entry_index_ < entries_.size() && entries_[entry_index_].tick <=
+            tick) {
+        const auto& entry = entries_[entry_index_++];
+        if (entry.is_midi) {
+            messages->push_back(MidiMessage{entry.data, entry.stamp});
+        } else {
+            events->push_back(entry.event);
+        }
+    }
+}
+
+bool InputLog::GetNextTick(int* delta) {
+    if (tick_index_ >= ticks_.size()) {
+        return false;
+    }
+    *delta = ticks_[tick_index_++];
+    return true;
+}
+
+bool InputLog::Load(const std::string& file_name) {
+    std::ifstream in{file_name};
+    std::string line;
+    if (!std::getline(in, line) || line != HEADER) {
+        std::cerr << "Error! Could not load input log \"" << file_name
+            << "\".\n";
+        return false;
+    }
+
+    entries_.clear();
+    ticks_.clear();
+    entry_index_ = tick_index_ = 0;
+    while (std::getline(in, line)) {
+        std::istringstream fields{line};
+        char kind;
+        fields >> kind;
+
+        if (kind == 'T') {
+            int delta;
+            fields >> delta;
+            ticks_.push_back(delta);
+        } else if (kind == 'E') {
+            // Only key events carry data that the Game uses
+            Entry entry;
+            int type, code;
+            fields >> entry.tick >> type >> code >> entry.event.key.alt
+                >> entry.event.key.control >> entry.event.key.shift
+                >> entry.event.key.system;
+            entry.is_midi = false;
+            entry.event.type = static_cast<sf::Event::EventType>(type);
+            entry.event.key.code = static_cast<sf::Keyboard::Key>(code);
+            entry.stamp = 0;
+            entries_.push_back(entry);
+        } else if (kind == 'M') {
+            Entry entry;
+            int size;
+            fields >> entry.tick >> entry.stamp >> size;
+            for (int i = 0; i < size; ++i) {
+                int byte;
+                fields >> byte;
+                entry.data.push_back(static_cast<unsigned char>(byte));
+            }
+            entry.is_midi = true;
+            entries_.push_back(entry);
+        }
+
+        if (fields.fail()) {
+            std::cerr << "Error! Malformed line in input log \"" << file_name
+                << "\": " << line << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InputLog::Save(const std::string& file_name) const {
+    std::ofstream out{file_name};
+    out << HEADER << '\n';
+    for (int delta : ticks_) {
+        out << "T " << delta << '\n';
+    }
+
+    // Timestamps are written at full precision so replayed messages are
+    // identical to recorded ones.
+    out << std::setprecision(17);
+    for (const auto& entry : entries_) {
+        if (entry.is_midi) {
+            out << "M " << entry.tick << ' ' << entry.stamp << ' '
+                << entry.data.size();
+            for (auto byte : entry.data) {
+                out << ' ' << static_cast<int>(byte);
+            }
+        } else {
+            bool is_key = entry.event.type == sf::Event::KeyPressed
+                || entry.event.type == sf::Event::KeyReleased;
+            out << "E " << entry.tick << ' ' << entry.event.type << ' '
+                << (is_key ? entry.event.key.code : 0) << ' '
+                << (is_key && entry.event.key.alt) << ' '
+                << (is_key && entry.event.key.control) << ' '
+                << (is_key && entry.event.key.shift) << ' '
+                << (is_key && entry.event.key.system);
+        }
+        out << '\n';
+    }
+
+    if (!out) {
+        std::cerr << "Error! Could not write input log \"" << file_name
+            << "\".\n";
+        return false;
+    }
+    return true;
+}
+
+}  // End namespace midistar
@@ -40,10 +40,11 @@ void InstrumentAutoPlayComponent::HandleCollisions(
         Game*
         , GameObject* o
         , int delta
-        , std::vector<GameObject*> colliding_with) {
+        , const VerticalCollisionDetectorComponent& contacts) {
     // We only use this component for handling AUTO PLAY, so check if it is
-    // enabled
+    // enabled. If not, there is never anything to do.
     if (!Config::GetInstance().GetAutomaticallyPlay()) {
+        o->Sleep(GetType());
         return;
     }
 
@@ -60,7 +61,7 @@ void InstrumentAutoPlayComponent::HandleCollisions(
 
     // Check each collision for collision with a song note
     if (!colliding_note_) {
-        for (auto& collider : colliding_with) {
+        for (auto& collider : contacts.GetCollidingWith()) {
             if (!collider->HasComponent(Component::SONG_NOTE)) {
                 continue;
             }
@@ -82,8 +83,7 @@ void InstrumentAutoPlayComponent::HandleCollisions(
     // Check that we are still colliding with the same note.
     // If we don't differentiate between notes, we will ignore and not play
     // overlapping notes.
-    if (std::find(colliding_with.begin(), colliding_with.end()
-                , colliding_note_) == colliding_with.end()) {
+    if (contacts.GetExited().Contains(colliding_note_)) {
         colliding_note_ = nullptr;
     }
 
@@ -24,7 +24,4 @@ InstrumentComponent::InstrumentComponent()
         : Component{Component::INSTRUMENT} {
 }
 
-void InstrumentComponent::Update(Game*, GameObject*, int) {
-}
-
 }  // End namespace midistar
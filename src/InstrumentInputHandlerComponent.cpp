@@ -33,13 +33,17 @@ InstrumentInputHandlerComponent::InstrumentInputHandlerComponent(
     , bool ctrl
     , bool shift)
         : Component{Component::INSTRUMENT_INPUT_HANDLER}
+        , activated_time_{0}
         , ctrl_{ctrl}
+        , has_press_time_{false}
         , key_{key}
         , key_down_{false}
+        , midi_down_{false}
         , note_played_{false}
+        , press_time_{0}
         , set_active_{false}
         , shift_{shift}
-        , uninvert_delay_{MAXIMUM_UNINVERT_DELAY}
+        , sounding_{false}
         , was_active_{false} {
 }
 
@@ -55,10 +59,19 @@ void InstrumentInputHandlerComponent::SetNotePlayed(bool note_played) {
     note_played_ = note_played;
 }
 
+bool InstrumentInputHandlerComponent::TakePressTime(double* time) {
+    if (!has_press_time_) {
+        return false;
+    }
+    *time = press_time_;
+    has_press_time_ = false;
+    return true;
+}
+
 void InstrumentInputHandlerComponent::Update(
         Game* g
         , GameObject* o
-        , int delta) {
+        , int) {
     // Check for required component
     auto note = o->GetComponent<NoteInfoComponent>(Component::NOTE_INFO);
     if (!note) {
@@ -67,17 +80,24 @@ void InstrumentInputHandlerComponent::Update(
 
     // Check SFML events for key presses
     for (const auto& e : g->GetSfEvents()) {
-        // Check if its the right key and event type
-        if (e.key.code != key_ || (e.type != sf::Event::KeyPressed
+        // Check if its the right key and event type. Instruments without a
+        // key binding ignore unmapped keys.
+        if (key_ == sf::Keyboard::Unknown || e.key.code != key_
+                || (e.type != sf::Event::KeyPressed
                     && e.type != sf::Event::KeyReleased)) {
             continue;
         }
 
         // Determine if the key is up or down and the required modifiers are
         // pressed.
+        bool was_down = key_down_;
         key_down_ = e.type == sf::Event::KeyPressed
             && ctrl_ == e.key.control
             && shift_ == e.key.shift;
+        if (key_down_ && !was_down) {
+            press_time_ = g->GetInputTime(e);
+            has_press_time_ = true;
+        }
     }
 
     // Handle MIDI input port events.
@@ -85,7 +105,11 @@ void InstrumentInputHandlerComponent::Update(
     // activate this instrument!
     for (const auto& msg : g->GetMidiInMessages()) {
         if (msg.IsNote() && msg.GetKey() == note->GetKey()) {
-            key_down_ = msg.IsNoteOn();
+            if (msg.IsNoteOn() && !midi_down_) {
+                press_time_ = g->GetInputTime(msg);
+                has_press_time_ = true;
+            }
+            midi_down_ = msg.IsNoteOn();
         }
     }
 
@@ -96,7 +120,7 @@ void InstrumentInputHandlerComponent::Update(
     }
 
     // If this instrument is activated...
-    if (key_down_ || set_active_) {
+    if (key_down_ || midi_down_ || set_active_) {
         // Set the GraphicsComponent and send a note on event
         if (!was_active_) {
             // If we've played another note before the instrument colour
@@ -110,35 +134,39 @@ void InstrumentInputHandlerComponent::Update(
                 o->SetComponent(new InvertColourComponent{0xa0});
             }
 
-            uninvert_delay_ = MAXIMUM_UNINVERT_DELAY;
+            activated_time_ = g->GetTimers().GetTime();
             o->SetComponent(new CollidableComponent{});
-            o->SetComponent(new MidiNoteComponent{
-                    true
-                    , note->GetChannel()
-                    , note->GetKey()
-                    , note->GetVelocity()});
+            sounding_ = key_down_ || set_active_ || !g->IsMidiThru();
+            if (sounding_) {
+                o->SetComponent(new MidiNoteComponent{
+                        true
+                        , note->GetChannel()
+                        , note->GetKey()
+                        , note->GetVelocity()});
+            }
             was_active_ = true;
-        } else {
-            // If we were activated in a previous tick, let's start counting
-            // down our uninvert delay.
-            uninvert_delay_ -= delta;
         }
     // If it's not activated and the CollidableComponent is set... (just played
     // a note).
     } else if (was_active_) {
         // Remove it and send a note off event
         o->DeleteComponent(Component::COLLIDABLE);
-        o->SetComponent(new MidiNoteComponent{
-                false
-                , note->GetChannel()
-                , note->GetKey()
-                , note->GetVelocity()
-            });
+        if (sounding_) {
+            o->SetComponent(new MidiNoteComponent{
+                    false
+                    , note->GetChannel()
+                    , note->GetKey()
+                    , note->GetVelocity()
+                });
+            sounding_ = false;
+        }
         // We want to delay the colour of the instrument being uninverted
-        // until a second after being played.
+        // until a second after being played. The time it was held counts
+        // towards the delay.
         o->SetComponent(new DelayedComponentComponent {
                 new InvertColourComponent{0xa0}
-                , uninvert_delay_
+                , MAXIMUM_UNINVERT_DELAY - (g->GetTimers().GetTime() -
+                        activated_time_)
             });
         // Add reset logic here.
         note_played_ = false;
@@ -0,0 +1,151 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midistar/MidiFileGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace midistar {
+
+MidiFileGenerator::MidiFileGenerator(const Parameters& params)
+        : file_{}
+        , params_{params}
+        , random_{params.seed}
+        , tempo_map_{} {
+}
+
+bool MidiFileGenerator::Write(const std::string& file_name) {
+    const auto& d = params_.note_length_distribution;
+    if (d != "fixed" && d != "uniform" && d != "exponential") {
+        std::cerr << "Error: unknown note length distribution \"" << d
+            << "\".\n";
+        return false;
+    }
+    if (params_.notes_per_second <= 0 || params_.length <= 0
+            || params_.chord_width < 1 || params_.num_tracks < 1
+            || params_.min_note_length <= 0
+            || params_.max_note_length < params_.min_note_length
+            || params_.lowest_key < 0 || params_.highest_key > 127
+            || params_.highest_key < params_.lowest_key) {
+        std::cerr << "Error: invalid MIDI file generator parameters.\n";
+        return false;
+    }
+
+    // Track 0 holds the tempo map. Notes are spread across the other tracks.
+    file_.setTicksPerQuarterNote(TICKS_PER_QUARTER_NOTE);
+    file_.addTracks(params_.num_tracks);
+    BuildTempoMap();
+    for (const auto& segment : tempo_map_) {
+        file_.addTempo(0, segment.start_tick, segment.tempo);
+    }
+
+    // Notes are started in chords, so chords are spaced such that we start
+    // notes_per_second notes each second.
+    std::vector<int> keys;
+    for (int k = params_.lowest_key; k <= params_.highest_key; ++k) {
+        keys.push_back(k);
+    }
+    int chord_width = std::min(params_.chord_width, static_cast<int>(
+                keys.size()));
+    double chord_interval = chord_width / params_.notes_per_second;
+
+    int chord = 0;
+    for (double t = 0; t < params_.length; t += chord_interval, ++chord) {
+        int track = chord % params_.num_tracks + 1;
+        int chan = (track - 1) % NUM_MELODIC_CHANNELS;
+        if (params_.percussion) {
+            chan = PERCUSSION_CHANNEL;
+        } else if (chan >= PERCUSSION_CHANNEL) {
+            ++chan;  // Skip the percussion channel for melodic notes
+        }
+
+        // Select unique keys for the chord by partially shuffling the key
+        // range. We use the generator output directly (rather than a
+        // std::uniform_int_distribution) so that files are identical across
+        // standard library implementations.
+        for (int i = 0; i < chord_width; ++i) {
+            int j = i + static_cast<int>(random_() % (keys.size() - i));
+            std::swap(keys[i], keys[j]);
+
+            double length = NextNoteLength();
+            file_.addNoteOn(track, SecondsToTick(t), chan, keys[i], 100);
+            file_.addNoteOff(track, SecondsToTick(t + length), chan, keys[i]);
+        }
+    }
+
+    file_.sortTracks();
+    if (!file_.write(file_name)) {
+        std::cerr << "Error! Could not write MIDI file \"" << file_name
+            << "\".\n";
+        return false;
+    }
+    std::cout << "Wrote " << chord * chord_width << " notes to \""
+        << file_name << "\".\n";
+    return true;
+}
+
+void MidiFileGenerator::BuildTempoMap() {
+    // Tempo changes are spaced evenly through the song
+    int num_segments = std::max(params_.num_tempo_changes, 0) + 1;
+    double segment_length = params_.length / num_segments;
+
+    tempo_map_.clear();
+    tempo_map_.push_back({0.0, 0, DEFAULT_TEMPO});
+    for (int i = 1; i < num_segments; ++i) {
+        double start = segment_length * i;
+        int start_tick = SecondsToTick(start);
+        double u = random_() / 4294967296.0;
+        tempo_map_.push_back({start, start_tick, MIN_TEMPO + u * (MAX_TEMPO
+                    - MIN_TEMPO)});
+    }
+}
+
+double MidiFileGenerator::NextNoteLength() {
+    double min = params_.min_note_length;
+    double max = params_.max_note_length;
+    double u = random_() / 4294967296.0;
+    const auto& d = params_.note_length_distribution;
+
+    if (d == "fixed") {
+        return min;
+    } else if (d == "uniform") {
+        return min + u * (max - min);
+    }
+
+    // Exponential: most notes are short, with a long tail up to the maximum.
+    double mean = (max - min) / 4.0;
+    return std::min(max, min - mean * std::log(1.0 - u));
+}
+
+int MidiFileGenerator::SecondsToTick(double seconds) const {
+    // Find the tempo segment containing this time
+    auto segment = tempo_map_.begin();
+    for (auto s = tempo_map_.begin(); s != tempo_map_.end(); ++s) {
+        if (s->start_seconds <= seconds) {
+            segment = s;
+        }
+    }
+
+    double beats = (seconds - segment->start_seconds) * segment->tempo / 60.0;
+    return segment->start_tick + static_cast<int>(std::lround(beats *
+                TICKS_PER_QUARTER_NOTE));
+}
+
+}  // End namespace midistar
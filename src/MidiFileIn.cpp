@@ -19,6 +19,7 @@
 #include "midistar/MidiFileIn.h"
 
 #include <iostream>
+#include <set>
 
 #include "midistar/Config.h"
 
@@ -26,8 +27,7 @@ namespace midistar {
 
 MidiFileIn::MidiFileIn()
         : channels_{0}
-        , index_{0}
-        , time_{0}
+        , schedule_{}
         , tracks_{0} {
 }
 
@@ -44,6 +44,11 @@ double MidiFileIn::GetMaximumNoteDuration() const {
     return max;
 }
 
+const std::vector<MidiFileIn::ScheduledNote>& MidiFileIn::GetNoteSchedule()
+        const {
+    return schedule_;
+}
+
 int MidiFileIn::GetTicksPerQuarterNote() const {
     return file_.getTicksPerQuarterNote();
 }
@@ -93,36 +98,20 @@ bool MidiFileIn::Init(const std::string& file_name) {
     if (!success) {
         std::cerr << "Error! Could not load MIDI file \"" << file_name << "\""
         << ".\n";
+        return false;
     }
-    return success;
-}
-
-bool MidiFileIn::IsEof() {
-    return index_ >= file_[0].size();
-}
 
-void MidiFileIn::Tick(int delta) {
-    time_ += delta;
-
-    smf::MidiEvent* mev;
-    while (!IsEof() && file_.getTimeInSeconds((mev = &file_[0][index_])->tick)
-                * 1000 <= time_) {
-        if (IsWanted(mev)) {
-            MidiMessage msg{
-                *mev
-                , mev->getDurationInSeconds()
-                , static_cast<double>(mev->tick)
-                , mev->track};
-            AddMessage(msg);
+    // Events are already sorted by time, so the schedule is too
+    schedule_.clear();
+    for (int i = 0; i < file_[0].size(); ++i) {
+        const auto& mev = file_[0][i];
+        if (mev.isNoteOn() && IsWanted(&mev)) {
+            schedule_.push_back({mev.getChannel(), mev.getDurationInSeconds()
+                    , mev.getP1(), file_.getTimeInSeconds(mev.tick) *
+                    1000, mev.track, mev.getP2()});
         }
-        ++index_;
-    }
-
-    // If MIDI file repeat is enabled, reset index when we encounter EOF
-    if (IsEof() && Config::GetInstance().GetMidiFileRepeat()) {
-        index_ = 0;
-        time_ = 0;
     }
+    return true;
 }
 
 bool MidiFileIn::IsWanted(const smf::MidiEvent* mev) const {
@@ -0,0 +1,130 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "midistar/MidiInputFilter.h"
+
+#include <iostream>
+
+namespace midistar {
+
+const char* const MidiInputFilter::TYPE_NAMES[NUM_MESSAGE_TYPES] = {
+    "active_sensing",
+    "channel_aftertouch",
+    "control_change",
+    "note_off",
+    "note_on",
+    "pitch_bend",
+    "poly_aftertouch",
+    "program_change",
+    "sysex",
+    "system",
+    "timing"
+};
+
+MidiInputFilter::MidiInputFilter()
+        : channel_mask_{ALL_CHANNELS}
+        , dropped_{0}
+        , passed_{0}
+        , type_mask_{(1u << NUM_MESSAGE_TYPES) - 1} {
+}
+
+bool MidiInputFilter::Accept(const std::vector<unsigned char>& data) {
+    // Only channel messages hold a channel, in their status byte
+    bool pass = !data.empty() && (type_mask_ >> GetType(data[0]) & 1) && (
+            (data[0] & COMMAND_MASK) == SYSTEM_COMMAND || (channel_mask_ >>
+                (data[0] & CHANNEL_MASK) & 1));
+    if (pass) {
+        passed_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return pass;
+}
+
+std::uint64_t MidiInputFilter::GetDropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t MidiInputFilter::GetPassed() const {
+    return passed_.load(std::memory_order_relaxed);
+}
+
+bool MidiInputFilter::Init(const std::vector<std::string>& ignored_types
+        , const std::vector<int>& channels) {
+    type_mask_ = (1u << NUM_MESSAGE_TYPES) - 1;
+    for (const auto& name : ignored_types) {
+        int type = 0;
+        while (type < NUM_MESSAGE_TYPES && name != TYPE_NAMES[type]) {
+            ++type;
+        }
+        if (type == NUM_MESSAGE_TYPES) {
+            std::cerr << "Error: unknown MIDI message type \"" << name
+                << "\".\n";
+            return false;
+        }
+        type_mask_ &= ~(1u << type);
+    }
+
+    channel_mask_ = 0;
+    for (int c : channels) {
+        if (c == -1) {
+            channel_mask_ = ALL_CHANNELS;
+            break;
+        }
+        if (c >= 0 && c < NUM_CHANNELS) {
+            channel_mask_ |= 1u << c;
+        }
+    }
+    return true;
+}
+
+MidiInputFilter::MessageType MidiInputFilter::GetType(unsigned char status) {
+    switch (status & COMMAND_MASK) {
+        case 0x80:
+            return NOTE_OFF;
+        case 0x90:
+            return NOTE_ON;
+        case 0xa0:
+            return POLY_AFTERTOUCH;
+        case 0xb0:
+            return CONTROL_CHANGE;
+        case 0xc0:
+            return PROGRAM_CHANGE;
+        case 0xd0:
+            return CHANNEL_AFTERTOUCH;
+        case 0xe0:
+            return PITCH_BEND;
+    }
+    switch (status) {
+        case 0xf0:  // Start of SysEx
+        case 0xf7:  // End of SysEx
+            return SYSEX;
+        case 0xf1:  // Time code quarter frame
+        case 0xf8:  // Clock
+        case 0xfa:  // Start
+        case 0xfb:  // Continue
+        case 0xfc:  // Stop
+            return TIMING;
+        case 0xfe:
+            return ACTIVE_SENSING;
+    }
+    return SYSTEM;
+}
+
+}  // End namespace midistar
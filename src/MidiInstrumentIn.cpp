@@ -22,6 +22,16 @@
 
 namespace midistar {
 
+MidiInstrumentIn::MidiInstrumentIn()
+        : MidiPortIn{}
+        , thru_{nullptr}
+        , thru_channel_{0} {
+}
+
+MidiInstrumentIn::~MidiInstrumentIn() {
+    Close();
+}
+
 bool MidiInstrumentIn::GetMessage(MidiMessage* message) {
     if (!MidiPortIn::GetMessage(message)) {
         return false;
@@ -34,4 +44,26 @@ bool MidiInstrumentIn::GetMessage(MidiMessage* message) {
     return true;
 }
 
+void MidiInstrumentIn::SetThru(MidiOut* out) {
+    thru_ = out;
+}
+
+void MidiInstrumentIn::SetThruChannel(int chan) {
+    thru_channel_ = chan;
+}
+
+void MidiInstrumentIn::OnReceive(const MidiMessage& message) {
+    if (!thru_ || !message.IsNote()) {
+        return;
+    }
+    int key = Config::GetInstance().GetInstrumentMidiNoteRemapping(message.
+            GetKey());
+    if (message.IsNoteOn()) {
+        thru_->SendNoteOn(key, thru_channel_, Config::GetInstance().
+                GetMidiOutVelocity());
+    } else {
+        thru_->SendNoteOff(key, thru_channel_);
+    }
+}
+
 }  // End namespace midistar
@@ -0,0 +1,53 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midistar/MidiMessageQueue.h"
+
+namespace midistar {
+
+MidiMessageQueue::MidiMessageQueue()
+        : head_{0}
+        , slots_{}
+        , tail_{0} {
+}
+
+bool MidiMessageQueue::Peek(MidiMessage* message) const {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    *message = slots_[head % CAPACITY];
+    return true;
+}
+
+void MidiMessageQueue::Pop() {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+            std::memory_order_release);
+}
+
+bool MidiMessageQueue::Push(const MidiMessage& message) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == CAPACITY) {
+        return false;
+    }
+    slots_[tail % CAPACITY] = message;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+}  // End namespace midistar
@@ -18,12 +18,20 @@
 
 #include "midistar/MidiOut.h"
 
+#include <iostream>
+
 #include "midistar/Config.h"
+#include "midistar/Utility.h"
 
 namespace midistar {
 
 MidiOut::MidiOut()
         : a_driver_{nullptr}
+        , file_renderer_{nullptr}
+        , render_failed_{false}
+        , rendered_samples_{0}
+        , resident_memory_{-1}
+        , s_font_id_{-1}
         , settings_{nullptr}
         , synth_{nullptr} {
 }
@@ -33,6 +41,10 @@ MidiOut::~MidiOut() {
         delete_fluid_audio_driver(a_driver_);
     }
 
+    if (file_renderer_) {
+        delete_fluid_file_renderer(file_renderer_);
+    }
+
     if (synth_) {
         delete_fluid_synth(synth_);
     }
@@ -46,30 +58,122 @@ bool MidiOut::Init() {
     settings_ = new_fluid_settings();
     fluid_settings_setstr(settings_, "audio.driver"
             , Config::GetInstance().GetAudioDriver().c_str());
+    fluid_settings_setint(settings_, "synth.dynamic-sample-loading", 1);
     synth_ = new_fluid_synth(settings_);
     if (!synth_) {
         std::cerr << "Error: could not create synth!\n";
     }
+    resident_memory_ = Utility::GetResidentMemory();
 
     a_driver_ = new_fluid_audio_driver(settings_, synth_);
     if (!a_driver_) {
         std::cerr << "Error: could not initialise audio driver!\n";
     }
 
+    return synth_ && a_driver_;
+}
+
+bool MidiOut::InitFileRenderer(const std::string& file_name) {
+    // Everything that affects the output is pinned, and the synth renders on
+    // this thread only, so renders are bit-identical between runs.
+    settings_ = new_fluid_settings();
+    fluid_settings_setstr(settings_, "audio.file.name", file_name.c_str());
+    fluid_settings_setstr(settings_, "audio.file.type", "wav");
+    fluid_settings_setint(settings_, "audio.period-size", BLOCK_SIZE);
+    fluid_settings_setint(settings_, "synth.cpu-cores", 1);
+    fluid_settings_setint(settings_, "synth.dynamic-sample-loading", 1);
+    fluid_settings_setnum(settings_, "synth.sample-rate", SAMPLE_RATE);
+    fluid_settings_setstr(settings_, "player.timing-source", "sample");
+    synth_ = new_fluid_synth(settings_);
+    if (!synth_) {
+        std::cerr << "Error: could not create synth!\n";
+        return false;
+    }
+    resident_memory_ = Utility::GetResidentMemory();
+
+    file_renderer_ = new_fluid_file_renderer(synth_);
+    if (!file_renderer_) {
+        std::cerr << "Error: could not open \"" << file_name << "\" for "
+            << "audio rendering!\n";
+        return false;
+    }
+    return true;
+}
+
+bool MidiOut::EndFileRender(int time) {
+    if (!file_renderer_) {
+        return !render_failed_;
+    }
+    for (int chan = 0; chan < NUM_CHANNELS; ++chan) {
+        fluid_synth_all_notes_off(synth_, chan);
+    }
+    return Render(time + RELEASE_TIME);
+}
+
+bool MidiOut::LoadSoundFont() {
     s_font_id_ = fluid_synth_sfload(synth_,
             Config::GetInstance().GetSoundFontPath().c_str(), 1);
     if (s_font_id_ == -1) {
         std::cerr << "Error: could not load SoundFont file!\n";
+        return false;
+    }
+    return true;
+}
+
+void MidiOut::PinPresets(std::ostream* out) {
+    if (!synth_ || s_font_id_ == -1) {
+        return;
     }
 
-    return synth_ && a_driver_ && s_font_id_ != -1;
+    // Older versions keep the presets selected on each channel loaded, and
+    // loading the SoundFont already selected these, so there is nothing to do
+#if FLUIDSYNTH_VERSION_MAJOR > 2 || (FLUIDSYNTH_VERSION_MAJOR == 2 \
+        && FLUIDSYNTH_VERSION_MINOR >= 2)
+    fluid_synth_pin_preset(synth_, s_font_id_, 0, 0);
+    fluid_synth_pin_preset(synth_, s_font_id_, DRUM_BANK, 0);
+#endif
+
+    *out << "SoundFont: pinned the piano and drum kit presets";
+    auto resident = Utility::GetResidentMemory();
+    if (resident_memory_ >= 0 && resident >= 0) {
+        *out << ", resident memory " << resident_memory_ / BYTES_PER_MB
+            << "MB before loading, " << resident / BYTES_PER_MB << "MB after";
+    }
+    *out << ".\n";
+}
+
+bool MidiOut::Render(int time) {
+    if (!file_renderer_) {
+        return !render_failed_;
+    }
+
+    // Render whole blocks until we reach the sample for this time
+    long long target = static_cast<long long>(time) * static_cast<long long>(
+            SAMPLE_RATE) / 1000;
+    while (rendered_samples_ + BLOCK_SIZE <= target) {
+        if (fluid_file_renderer_process_block(file_renderer_) != FLUID_OK) {
+            std::cerr << "Error: could not write rendered audio!\n";
+            delete_fluid_file_renderer(file_renderer_);
+            file_renderer_ = nullptr;
+            render_failed_ = true;
+            return false;
+        }
+        rendered_samples_ += BLOCK_SIZE;
+    }
+    return true;
 }
 
 void MidiOut::SendNoteOff(int note, int chan) {
+    if (!synth_) {  // Headless games don't initialise MIDI output
+        return;
+    }
     fluid_synth_noteoff(synth_, chan, note);
 }
 
 void MidiOut::SendNoteOn(int note, int chan, int velocity) {
+    if (!synth_) {
+        return;
+    }
     fluid_synth_noteon(synth_, chan, note, velocity);
 }
 
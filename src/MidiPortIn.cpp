@@ -18,38 +18,98 @@
 
 #include "midistar/MidiPortIn.h"
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <unordered_map>
 #include <vector>
 
+#include "midistar/Config.h"
+
 namespace midistar {
 
 MidiPortIn::MidiPortIn(bool extend_same_tick_notes)
         : extend_same_tick_notes_{extend_same_tick_notes}
-        , midi_in_{nullptr} {
+        , filter_{}
+        , ports_{}
+        , ports_mutex_{}
+        , probe_{nullptr}
+        , received_{}
+        , same_tick_buffer_{}
+        , scanner_{}
+        , scanner_changed_{}
+        , scanner_mutex_{}
+        , stopping_{false} {
 }
 
 MidiPortIn::MidiPortIn()
         : MidiPortIn(true) {
 }
 
+MidiPortIn::~MidiPortIn() {
+    Close();
+}
+
+void MidiPortIn::Close() {
+    if (scanner_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock{scanner_mutex_};
+            stopping_ = true;
+        }
+        scanner_changed_.notify_all();
+        scanner_.join();
+    }
+
+    // Deleting a port stops its callback, which may be running
+    std::vector<Port*> closed;
+    {
+        std::lock_guard<std::mutex> lock{ports_mutex_};
+        closed.swap(ports_);
+    }
+    for (auto port : closed) {
+        delete port->midi_in;
+        delete port;
+    }
+    delete probe_;
+    probe_ = nullptr;
+}
+
+double MidiPortIn::GetClockTime() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().
+            time_since_epoch()).count();
+}
+
+const MidiInputFilter& MidiPortIn::GetFilter() const {
+    return filter_;
+}
+
 bool MidiPortIn::Init() {
-    midi_in_ = new RtMidiIn();
+    if (!filter_.Init(Config::GetInstance().GetMidiInIgnore(), Config::
+                GetInstance().GetMidiInChannels())) {
+        std::cerr << "Warning: MIDI input disabled.\n";
+        return false;
+    }
 
     try {
-        midi_in_->openPort(0, "midistar Input");
+        probe_ = new RtMidiIn();
     } catch (...) {
-        std::cerr << "Warning: error opening MIDI input port. MIDI input "
+        std::cerr << "Warning: error listing MIDI input ports. MIDI input "
             << "disabled.\n";
+        return false;
     }
-    midi_in_->ignoreTypes(false, false, false);
-    return midi_in_;
-}
 
-void MidiPortIn::Tick() {
-    if (!midi_in_) {
-        return;
+    // Ports that are already plugged in are opened straight away, so the
+    // first song does not start without them
+    Scan();
+    if (ports_.empty()) {
+        std::cerr << "Warning: no MIDI input port found. Ports plugged in "
+            << "later will be opened.\n";
     }
+    scanner_ = std::thread{&MidiPortIn::RunScanner, this};
+    return true;
+}
 
+void MidiPortIn::Tick() {
     // Here we go handle the cached note on/off events from last tick (see
     // below)
     std::unordered_map<int, MidiMessage> this_tick;
@@ -66,18 +126,36 @@ void MidiPortIn::Tick() {
         }
     }
 
-    std::vector<unsigned char> data;
-    while (true) {
-        double stamp = midi_in_->getMessage(&data);
-        if (data.size() == 0) {
-            break;
+    // Each port's queue is already in arrival order, so the queues are
+    // merged by repeatedly taking the earliest message at the front of any
+    // of them. There are only ever a few ports, so they are searched in turn.
+    received_.clear();
+    {
+        std::lock_guard<std::mutex> lock{ports_mutex_};
+        MidiMessage front;
+        MidiMessage earliest;
+        while (true) {
+            Port* from = nullptr;
+            for (auto port : ports_) {
+                if (port->queue.Peek(&front) && (!from || front.GetTime() <
+                            earliest.GetTime())) {
+                    earliest = front;
+                    from = port;
+                }
+            }
+            if (!from) {
+                break;
+            }
+            from->queue.Pop();
+            received_.push_back(earliest);
         }
+    }
 
+    for (const auto& midi_message : received_) {
         // Here we check if we've already had a note event with the same key
         // for this tick. If we have, and the extend_same_tick_notes option
         // is enabled, we cache the note for next tick. This stops a note play
         // from being totally ignored because it happened faster than a tick.
-        MidiMessage midi_message{ data, stamp };
         if (extend_same_tick_notes_ && midi_message.IsNote()
                 && this_tick.count(midi_message.GetKey())) {
             same_tick_buffer_.emplace(midi_message);
@@ -88,4 +166,133 @@ void MidiPortIn::Tick() {
     }
 }
 
+void MidiPortIn::OnReceive(const MidiMessage&) {
+}
+
+void MidiPortIn::OnRtMidiMessage(double stamp, std::vector<unsigned char>*
+        data, void* port) {
+    auto p = static_cast<Port*>(port);
+
+    // RtMidi stamps each message with the time since the port's previous
+    // message, as measured by the MIDI driver. Adding these up keeps the
+    // spacing between messages accurate even if the callback runs late. A
+    // message can never arrive in the future, which bounds any clock drift.
+    double now = GetClockTime();
+    p->last_time = p->last_time < 0 ? now : std::min(now, p->last_time +
+            stamp);
+    if (!p->owner->filter_.Accept(*data)) {
+        return;
+    }
+
+    MidiMessage message{*data, p->last_time};
+    if (message.IsNote()) {
+        message.SetKey(Config::GetInstance().GetMidiInPortNoteRemapping(
+                    p->index, message.GetKey()));
+    }
+    p->owner->OnReceive(message);
+
+    // If the game stops reading the queue for long enough, it fills up and
+    // further messages are dropped
+    p->queue.Push(message);
+}
+
+void MidiPortIn::RunScanner() {
+    std::unique_lock<std::mutex> lock{scanner_mutex_};
+    while (!scanner_changed_.wait_for(lock, std::chrono::milliseconds(
+                    SCAN_INTERVAL), [this] { return stopping_; })) {
+        lock.unlock();
+        Scan();
+        lock.lock();
+    }
+}
+
+void MidiPortIn::Scan() {
+    // Only this function changes ports_, so it can read ports_ unlocked
+    std::vector<std::string> names;
+    try {
+        auto count = probe_->getPortCount();
+        for (unsigned i = 0; i < count; ++i) {
+            names.push_back(probe_->getPortName(i));
+        }
+    } catch (...) {
+        return;  // Try again next time
+    }
+
+    // Close ports that have been unplugged. Unplugging a port can renumber
+    // the ports after it, which are then closed here and opened again below
+    // under their new numbers.
+    std::vector<Port*> closed;
+    {
+        std::lock_guard<std::mutex> lock{ports_mutex_};
+        auto unplugged = std::stable_partition(ports_.begin(), ports_.end(),
+                [&names](const Port* p) {
+                    return p->number < names.size() && names[p->number] ==
+                        p->name;
+                });
+        closed.assign(unplugged, ports_.end());
+        ports_.erase(unplugged, ports_.end());
+    }
+    for (auto port : closed) {
+        std::cout << "Closed MIDI input port \"" << port->name << "\".\n";
+        delete port->midi_in;
+        delete port;
+    }
+
+    // Open a port for each configured port that does not have one. A port is
+    // given by number, or by part of its name. Ports are told apart by
+    // number, so identical devices with the same name can all be opened.
+    auto wanted = Config::GetInstance().GetMidiInPorts();
+    auto is_open = [this](int number) {
+        return std::any_of(ports_.begin(), ports_.end(), [number](const Port*
+                    p) { return p->number == static_cast<unsigned>(number); });
+    };
+    for (int i = 0; i < static_cast<int>(wanted.size()); ++i) {
+        if (std::any_of(ports_.begin(), ports_.end(), [i](const Port* p) {
+                    return p->index == i; })) {
+            continue;
+        }
+
+        const auto& w = wanted[i];
+        int number = -1;
+        if (!w.empty() && std::all_of(w.begin(), w.end(), [](char c) {
+                    return c >= '0' && c <= '9'; })) {
+            number = std::stoi(w);
+            if (number >= static_cast<int>(names.size())) {
+                number = -1;
+            }
+        } else {
+            for (int n = 0; n < static_cast<int>(names.size()); ++n) {
+                if (names[n].find(w) != std::string::npos && !is_open(n)) {
+                    number = n;
+                    break;
+                }
+            }
+        }
+        if (number < 0 || is_open(number)) {
+            continue;
+        }
+
+        auto port = new Port{i, -1, nullptr, names[number], static_cast<
+            unsigned>(number), this, {}};
+        try {
+            port->midi_in = new RtMidiIn();
+            port->midi_in->openPort(number, "midistar Input");
+        } catch (...) {
+            std::cerr << "Warning: error opening MIDI input port \""
+                << port->name << "\".\n";
+            delete port->midi_in;
+            delete port;
+            continue;
+        }
+        // Every message type is let through RtMidi, so the filter counts
+        // them all
+        port->midi_in->ignoreTypes(false, false, false);
+        port->midi_in->setCallback(&MidiPortIn::OnRtMidiMessage, port);
+
+        std::lock_guard<std::mutex> lock{ports_mutex_};
+        ports_.push_back(port);
+        std::cout << "Opened MIDI input port \"" << port->name << "\".\n";
+    }
+}
+
 }  // End namespace midistar
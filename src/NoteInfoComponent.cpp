@@ -48,7 +48,4 @@ int NoteInfoComponent::GetVelocity() {
     return vel_;
 }
 
-void NoteInfoComponent::Update(Game*, GameObject*, int) {
-}
-
 }  // End namespace midistar
@@ -0,0 +1,153 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "midistar/NoteLayer.h"
+
+#include <algorithm>
+
+#include "midistar/PhysicsComponent.h"
+
+namespace midistar {
+
+NoteLayer::NoteLayer()
+        : activation_times_{}
+        , active_{false}
+        , buffer_{sf::Quads, sf::VertexBuffer::Static}
+        , changed_{false}
+        , speed_{0}
+        , vertices_{} {
+}
+
+void NoteLayer::Clear() {
+    activation_times_.clear();
+    active_ = false;
+    changed_ = true;
+    speed_ = 0;
+    vertices_.clear();
+}
+
+void NoteLayer::Draw(sf::RenderTarget* target, std::size_t first, double
+        song_time) {
+    // If vertex buffers aren't supported, the vertices are drawn directly
+    if (changed_) {
+        changed_ = false;
+        if (vertices_.empty() || !sf::VertexBuffer::isAvailable() || !buffer_.
+                create(vertices_.size()) || !buffer_.update(vertices_.data())) {
+            buffer_.create(0);
+        }
+    }
+    if (!active_ || first >= activation_times_.size()) {
+        return;
+    }
+
+    // Activated notes are at the start of the buffer, so we skip past them
+    sf::RenderStates states;
+    states.transform.translate(0, static_cast<float>(speed_ * song_time));
+    auto offset = first * VERTICES_PER_NOTE;
+    auto count = vertices_.size() - offset;
+    if (buffer_.getVertexCount()) {
+        target->draw(buffer_, offset, count, states);
+    } else {
+        target->draw(&vertices_[offset], count, sf::Quads, states);
+    }
+}
+
+double NoteLayer::GetActivationTime(std::size_t index) const {
+    return activation_times_[index];
+}
+
+bool NoteLayer::Init(const std::vector<MidiFileIn::ScheduledNote>& schedule
+        , GameObjectFactory* factory, double activation_y) {
+    Clear();
+    vertices_.reserve(schedule.size() * VERTICES_PER_NOTE);
+    auto add_quad = [this](float x, float y, float w, float h, const
+            sf::Color& colour) {
+        w = std::max(w, 0.0f);
+        h = std::max(h, 0.0f);
+        vertices_.push_back({{x, y}, colour});
+        vertices_.push_back({{x + w, y}, colour});
+        vertices_.push_back({{x + w, y + h}, colour});
+        vertices_.push_back({{x, y + h}, colour});
+    };
+
+    for (const auto& n : schedule) {
+        // Create the note to find out what it looks like and how it moves
+        auto note = factory->CreateSongNote(n.track, n.channel, n.key
+                , n.velocity, n.duration);
+        auto rect = note->GetDrawformable<sf::RectangleShape>();
+        auto physics = note->GetComponent<PhysicsComponent>(
+                Component::PHYSICS);
+        double x_vel = 0, y_vel = 0;
+        if (physics) {
+            physics->GetVelocity(&x_vel, &y_vel);
+        }
+        if (!rect || x_vel != 0 || y_vel <= 0 || (speed_ && y_vel !=
+                    speed_)) {
+            delete note;
+            Clear();
+            return false;
+        }
+        speed_ = y_vel;
+
+        // The layer is moved down by the distance notes have fallen since
+        // the song started, so each note is placed where it would be at
+        // song time zero.
+        double x, y, w, h;
+        note->GetPosition(&x, &y);
+        note->GetSize(&w, &h);
+        auto top = static_cast<float>(y - speed_ * n.time);
+        auto left = static_cast<float>(x);
+        auto width = static_cast<float>(w);
+        auto height = static_cast<float>(h);
+        auto thickness = rect->getOutlineThickness();
+        auto outer = std::max(thickness, 0.0f);
+        auto inner = std::max(-thickness, 0.0f);
+        add_quad(left - outer, top - outer, width + outer * 2, height + outer
+                * 2, rect->getOutlineColor());
+        add_quad(left + inner, top + inner, width - inner * 2, height - inner
+                * 2, rect->getFillColor());
+
+        // Notes are activated in schedule order, once their bottom edge
+        // reaches the activation line
+        double activation_time = n.time + (activation_y - (y + h)) / speed_;
+        if (!activation_times_.empty()) {
+            activation_time = std::max(activation_time, activation_times_.
+                    back());
+        }
+        activation_times_.push_back(std::max(activation_time, n.time));
+        delete note;
+    }
+    active_ = true;
+    return true;
+}
+
+bool NoteLayer::IsActive() const {
+    return active_;
+}
+
+void NoteLayer::Take(NoteLayer* other) {
+    activation_times_.swap(other->activation_times_);
+    active_ = other->active_;
+    changed_ = true;
+    speed_ = other->speed_;
+    vertices_.swap(other->vertices_);
+    other->Clear();
+}
+
+}  // End namespace midistar
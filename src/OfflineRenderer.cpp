@@ -0,0 +1,92 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "midistar/OfflineRenderer.h"
+
+#include <iostream>
+#include <SFML/Graphics.hpp>
+
+#include "midistar/Config.h"
+#include "midistar/FrameWriter.h"
+#include "midistar/Game.h"
+
+namespace midistar {
+
+bool OfflineRenderer::Run() {
+    // Standard output may be carrying frames, so we report to standard error
+    auto& config = Config::GetInstance();
+    int fps = config.GetRenderFramesPerSecond();
+    if (fps <= 0) {
+        std::cerr << "Error: the render frame rate must be positive.\n";
+        return false;
+    }
+
+    Game game{true};
+    if (!game.Init()) {
+        return false;
+    }
+
+    // Video is optional; audio only renders don't need to draw anything
+    auto video = config.GetRenderVideo();
+    sf::RenderTexture texture;
+    FrameWriter writer;
+    if (!video.empty()) {
+        if (!texture.create(config.GetScreenWidth(), config.
+                    GetScreenHeight())) {
+            std::cerr << "Error! Could not create a " << config.
+                GetScreenWidth() << "x" << config.GetScreenHeight()
+                << " render texture.\n";
+            return false;
+        }
+        game.SetRenderTarget(&texture);
+        if (!writer.Init(video, config.GetRenderThreads())) {
+            return false;
+        }
+    }
+
+    // Frame N is shown at N * 1000 / fps milliseconds. Ticks are whole
+    // milliseconds, so we step between frame times rather than using a fixed
+    // delta, which would drift away from the frame rate.
+    sf::Clock clock;
+    bool ok = true;
+    int frame = 0;
+    for (; ok && game.IsRunning() && frame < MAX_FRAMES; ++frame) {
+        int delta = static_cast<int>((frame + 1) * 1000LL / fps - frame *
+                1000LL / fps);
+        game.Tick(delta);
+        if (!video.empty()) {
+            texture.display();
+            ok = writer.Write(texture.getTexture().copyToImage());
+        }
+    }
+    ok = game.FinishAudioRender() && ok;
+    ok = writer.Finish() && ok;
+
+    double elapsed = clock.getElapsedTime().asSeconds();
+    double length = frame / static_cast<double>(fps);
+    std::cerr << "Rendered " << frame << " frames ("
+        << length << "s at " << fps << " FPS) in " << elapsed << "s";
+    if (elapsed > 0) {
+        std::cerr << ", " << length / elapsed << "x real time";
+    }
+    std::cerr << ".\n";
+    return ok;
+}
+
+}  // End namespace midistar
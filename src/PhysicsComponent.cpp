@@ -21,26 +21,50 @@
 namespace midistar {
 PhysicsComponent::PhysicsComponent(double x_vel, double y_vel)
         : Component{Component::PHYSICS}
+        , elapsed_{0}
+        , has_origin_{false}
+        , last_x_{0}
+        , last_y_{0}
+        , origin_x_{0}
+        , origin_y_{0}
         , x_vel_{x_vel}
         , y_vel_{y_vel} {
 }
 
+void PhysicsComponent::Advance(GameObject* o, double time) {
+    double x, y;
+    o->GetPosition(&x, &y);
+    if (!has_origin_) {
+        origin_x_ = x;
+        origin_y_ = y;
+        has_origin_ = true;
+    } else {
+        // Keep any moves made since we last moved the owner
+        origin_x_ += x - last_x_;
+        origin_y_ += y - last_y_;
+    }
+
+    elapsed_ += time;
+    last_x_ = origin_x_ + x_vel_ * elapsed_;
+    last_y_ = origin_y_ + y_vel_ * elapsed_;
+    o->SetPosition(last_x_, last_y_);
+}
+
 void PhysicsComponent::GetVelocity(double* x_vel, double* y_vel) {
     *x_vel = x_vel_;
     *y_vel = y_vel_;
 }
 
 void PhysicsComponent::SetVelocity(double x_vel, double y_vel) {
+    // Move the origin so that the current position stays the same
+    origin_x_ += (x_vel_ - x_vel) * elapsed_;
+    origin_y_ += (y_vel_ - y_vel) * elapsed_;
     x_vel_ = x_vel;
     y_vel_ = y_vel;
 }
 
 void PhysicsComponent::Update(Game*, GameObject* o, int delta) {
-    double x, y;
-    o->GetPosition(&x, &y);
-    x += x_vel_ * delta;
-    y += y_vel_ * delta;
-    o->SetPosition(x, y);
+    Advance(o, delta);
 }
 
 }   // namespace midistar
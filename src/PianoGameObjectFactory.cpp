@@ -16,6 +16,7 @@
  * this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 
 #include "midistar/PianoGameObjectFactory.h"
@@ -33,7 +34,6 @@
 #include "midistar/ResizeComponent.h"
 #include "midistar/PianoSongNoteCollisionHandlerComponent.h"
 #include "midistar/SongNoteComponent.h"
-#include "midistar/SpriteAnimatorComponent.h"
 #include "midistar/Utility.h"
 #include "midistar/VerticalCollisionDetectorComponent.h"
 
@@ -48,48 +48,67 @@ const sf::Color PianoGameObjectFactory::MIDI_TRACK_COLOURS[NUM_TRACK_COLOURS] {
     , sf::Color{244, 244, 65}, sf::Color{88, 65, 244}, sf::Color{65, 235, 244}
 };
 
-const bool PianoGameObjectFactory::OCTAVE_BLACK_KEYS[NOTES_PER_OCTAVE] {
-    0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 1
-};
+constexpr bool PianoGameObjectFactory::OCTAVE_BLACK_KEYS[NOTES_PER_OCTAVE];
+
+constexpr char PianoGameObjectFactory::OCTAVE_KEY_TO_WHITE_KEY[
+    NOTES_PER_OCTAVE];
+
+constexpr PianoGameObjectFactory::KeyTable PianoGameObjectFactory::
+        MakeKeyTable() {
+    // Here we find the layout of each MIDI key from its position in its
+    // octave. MIDI keys that are assigned to a black key use the previous
+    // white key.
+    KeyTable table{};
+    for (int key = 0; key < NUM_MIDI_KEYS; ++key) {
+        // Keys below the first piano key belong to negative octaves
+        int key_index = key - PIANO_FIRST_MIDI_KEY;
+        int octave_num = key_index >= 0 ? key_index / NOTES_PER_OCTAVE :
+            (key_index + 1) / NOTES_PER_OCTAVE - 1;
+        int octave_index = key_index - octave_num * NOTES_PER_OCTAVE;
+        table.black[key] = OCTAVE_BLACK_KEYS[octave_index];
+        table.white_index[key] = octave_num * WHITE_KEYS_PER_OCTAVE +
+            OCTAVE_KEY_TO_WHITE_KEY[octave_index];
+    }
+    return table;
+}
 
-const char PianoGameObjectFactory::OCTAVE_KEY_TO_WHITE_KEY[NOTES_PER_OCTAVE] {
-    0, 0, 1, 2, 2, 3, 3, 4, 5, 5, 6, 6
-};
+const PianoGameObjectFactory::KeyTable PianoGameObjectFactory::KEY_TABLE{
+    MakeKeyTable()};
 
 PianoGameObjectFactory::PianoGameObjectFactory(double note_speed)
         : GameObjectFactory{note_speed, BACKGROUND_COLOUR}
-        , grinding_texture_{}
+        , grinding_frames_{1}
         , white_width_{Config::GetInstance().GetScreenWidth() /
             static_cast<double>(NUM_WHITE_KEYS)} {
 }
 
-GameObject* PianoGameObjectFactory::CreateNotePlayEffect(GameObject* inst) {
-    // Create a sprite from a spritesheet using the first frame
-    auto sprite = new sf::Sprite{grinding_texture_, {0, 0, static_cast<int>(
-            GRINDING_SPRITE_SIZE), static_cast<int>(GRINDING_SPRITE_SIZE)}};
-    sprite->setColor(GRINDING_SPRITE_COLOUR);
+GameObjectFactory* PianoGameObjectFactory::Create(double note_speed, const
+        MidiFileIn&) {
+    return new PianoGameObjectFactory(note_speed);
+}
 
-    // Set the sprite scale to match the instrument
+bool PianoGameObjectFactory::CreateNotePlayEffect(
+        GameObject* inst
+        , EffectSystem::Effect* effect) {
+    // Size the effect to match the instrument, at half the height
     double x, y, w, h;
     inst->GetPosition(&x, &y);
     inst->GetSize(&w, &h);
-    double sprite_scale_x = w * 2 / GRINDING_SPRITE_SIZE;
-    double sprite_scale_y = sprite_scale_x / 2.0f;  // Reduce height
-    double sprite_w = sprite_scale_x * GRINDING_SPRITE_SIZE;
-    double sprite_h = sprite_scale_y * GRINDING_SPRITE_SIZE;
-    sprite->setScale(static_cast<float>(sprite_scale_x), static_cast<float>(
-        sprite_scale_y));
-
-    // Create the GameObject to hold the sprite
-    auto obj = new GameObject{sprite, x + (w / 2.0f) - (sprite_w / 2.0f)
-        , y - sprite_h, sprite_w, sprite_h};
-
-    // Animate the sprite
-    int frame = static_cast<int>(x) % static_cast<int>(
-            sprite->getTexture()->getSize().x / GRINDING_SPRITE_SIZE);
-    obj->SetComponent(new SpriteAnimatorComponent{static_cast<int>(
-                GRINDING_SPRITE_SIZE), 0, frame, GRINDING_FRAMES_PER_SECOND});
-    return obj;
+    double effect_w = w * 2;
+    double effect_h = effect_w / 2.0f;  // Reduce height
+
+    // Start the animation on a frame that depends on the position, so
+    // neighbouring effects are out of step
+    effect->x = static_cast<float>(x + (w / 2.0f) - (effect_w / 2.0f));
+    effect->y = static_cast<float>(y - effect_h);
+    effect->width = static_cast<float>(effect_w);
+    effect->height = static_cast<float>(effect_h);
+    effect->colour = GRINDING_SPRITE_COLOUR;
+    effect->row = 0;
+    effect->frame = static_cast<int>(x) % grinding_frames_;
+    effect->num_frames = grinding_frames_;
+    effect->ms_per_frame = 1000 / GRINDING_FRAMES_PER_SECOND;
+    return true;
 }
 
 std::vector<GameObject*> PianoGameObjectFactory::CreateInstrument() {
@@ -139,12 +158,21 @@ GameObject* PianoGameObjectFactory::CreateSongNote(
     song_note->SetComponent(new PhysicsComponent{0, GetNoteSpeed()});
     song_note->SetComponent(new DeleteOffscreenComponent{});
     song_note->SetComponent(new VerticalCollisionDetectorComponent{});
-    song_note->SetComponent(new PianoSongNoteCollisionHandlerComponent{});
+    song_note->SetComponent(new PianoSongNoteCollisionHandlerComponent{
+            GetInstrumentY()});
     return song_note;
 }
 
 bool PianoGameObjectFactory::Init() {
-    return grinding_texture_.loadFromFile(GRINDING_TEXTURE_PATH);
+    // The grinding spritesheet is used as the effect atlas
+    sf::Image atlas;
+    if (!atlas.loadFromFile(GRINDING_TEXTURE_PATH)) {
+        return false;
+    }
+    grinding_frames_ = std::max(1, static_cast<int>(atlas.getSize().x /
+                GRINDING_SPRITE_SIZE));
+    SetEffectAtlas(atlas, static_cast<int>(GRINDING_SPRITE_SIZE));
+    return true;
 }
 
 sf::Color PianoGameObjectFactory::GetTrackColour(int midi_track) {
@@ -169,29 +197,21 @@ void PianoGameObjectFactory::GetInstrumentKeyBinding(
     *ctrl = false;
 }
 
+double PianoGameObjectFactory::GetInstrumentY() {
+    return Config::GetInstance().GetScreenHeight() - WHITE_KEY_HEIGHT -
+        (Config::GetInstance().GetScreenHeight() * KEY_HOVER_PERCENTAGE);
+}
+
 int PianoGameObjectFactory::GetWhiteKeyIndex(int midi_key) {
-    // Here we find the white key index for any given MIDI key. MIDI keys that
-    // are assigned to a black key will return the previous white key.
-    int key_index = midi_key - PIANO_FIRST_MIDI_KEY;
-    int octave_num = key_index / NOTES_PER_OCTAVE;
-    int prev_white_keys = octave_num * WHITE_KEYS_PER_OCTAVE;
-    int octave_index = key_index % NOTES_PER_OCTAVE;
-    int result =  prev_white_keys + OCTAVE_KEY_TO_WHITE_KEY[octave_index];
+    assert(midi_key >= 0 && midi_key < NUM_MIDI_KEYS);
+    int result = KEY_TABLE.white_index[midi_key];
     assert(result >= 0 && result < NUM_WHITE_KEYS);
     return result;
 }
 
 bool PianoGameObjectFactory::IsBlackKey(int midi_key) {
-    // The OCTAVE_BLACK_KEYS array indicates black keys in a typical octave.
-    // To find if a specific key is a black key, we subtract the first piano
-    // MIDI key (the MIDI key of the first key on a piano), and find the
-    // remainder if we divide by NOTES_PER_OCTAVE.
-    //
-    // This gives us a value between 0 and NOTES_PER_OCTAVE, that we can use
-    // as an index in the OCTAVE_BALCK_KEYS array. We return the value at this
-    // index.
-    return OCTAVE_BLACK_KEYS[(midi_key - PIANO_FIRST_MIDI_KEY)
-        % NOTES_PER_OCTAVE];
+    assert(midi_key >= 0 && midi_key < NUM_MIDI_KEYS);
+    return KEY_TABLE.black[midi_key];
 }
 
 double PianoGameObjectFactory::CalculateXPosition(int midi_key) {
@@ -225,8 +245,7 @@ GameObject* PianoGameObjectFactory::CreateInstrumentNote(int note) {
 
     // Create the underlying shape
     double x = CalculateXPosition(note);
-    double y = Config::GetInstance().GetScreenHeight() - WHITE_KEY_HEIGHT -
-        (Config::GetInstance().GetScreenHeight() * KEY_HOVER_PERCENTAGE);
+    double y = GetInstrumentY();
     sf::RectangleShape* rect = new sf::RectangleShape{{static_cast<float>(
             width), static_cast<float>(height)}};
     rect->setFillColor(colour);
@@ -19,91 +19,163 @@
 #include "midistar/PianoSongNoteCollisionHandlerComponent.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "midistar/Config.h"
+#include "midistar/EffectSystem.h"
 #include "midistar/MidiNoteComponent.h"
 #include "midistar/NoteInfoComponent.h"
-#include "midistar/ResizeComponent.h"
+#include "midistar/PhysicsComponent.h"
 #include "midistar/VerticalCollisionDetectorComponent.h"
 
 namespace midistar {
 
-PianoSongNoteCollisionHandlerComponent::PianoSongNoteCollisionHandlerComponent()
+PianoSongNoteCollisionHandlerComponent::PianoSongNoteCollisionHandlerComponent(
+    double instrument_y)
         : CollisionHandlerComponent{Component::NOTE_COLLISION_HANDLER}
-        , grinding_{nullptr} {
+        , game_{nullptr}
+        , grinding_{EffectSystem::NO_EFFECT}
+        , has_thresholds_{false}
+        , instrument_{nullptr}
+        , instrument_y_{instrument_y}
+        , missed_time_{0}
+        , playable_time_{0}
+        , start_time_{0}
+        , state_{APPROACHING}
+        , timers_{nullptr}
+        , wake_timer_{TimerWheel::NO_TIMER} {
+}
+
+PianoSongNoteCollisionHandlerComponent::
+        ~PianoSongNoteCollisionHandlerComponent() {
+    if (game_) {
+        game_->RemoveEffect(grinding_);
+    }
+    if (timers_) {
+        timers_->Cancel(wake_timer_);
+    }
+}
+
+PianoSongNoteCollisionHandlerComponent::State
+        PianoSongNoteCollisionHandlerComponent::GetState() const {
+    return state_;
 }
 
 void PianoSongNoteCollisionHandlerComponent::HandleCollisions(
         Game* g
         , GameObject* o
         , int
-        , std::vector<GameObject*> colliding_with) {
-    // Handle each collision
-    GameObject* valid_collider = nullptr;
-    for (auto& collider : colliding_with) {
-         if (HandleCollision(g, o, collider)) {
-            valid_collider = collider;
-        }
+        , const VerticalCollisionDetectorComponent& contacts) {
+    // Keep track of the instrument in contact, even before the note is
+    // playable, as it may be held down while the note arrives
+    UpdateInstrument(o, contacts);
+    if (!has_thresholds_ && !InitThresholds(g, o)) {
+        return;
     }
 
-    // If we are being played, let's add a grinding effect
-    if (valid_collider) {
-        if (grinding_) {
-            return;
-        }
-        grinding_ = g->GetGameObjectFactory().CreateNotePlayEffect(
-            valid_collider);
-        g->AddGameObject(grinding_);
-    } else if (grinding_) {  // Otherwise remove the grinding effect
-        grinding_->SetRequestDelete(true);
-        grinding_ = nullptr;
+    // Move on as the note passes each threshold
+    double time = timers_->GetTime() - start_time_;
+    if (state_ == APPROACHING && time >= playable_time_) {
+        state_ = PLAYABLE;
+    }
+    if (state_ == PLAYABLE && time >= missed_time_) {
+        state_ = MISSED;
     }
-}
 
-bool PianoSongNoteCollisionHandlerComponent::HandleCollision(
-        Game* g
-        , GameObject* o
-        , GameObject* collider) {
-    // We only want to handle collisions with instruments
-    if (!collider->HasComponent(Component::INSTRUMENT)) {
-        return false;
+    // Nothing can collide with the note until it reaches the instrument, so
+    // collisions aren't checked until then. Once the note has been missed or
+    // played, they are never checked again.
+    if (state_ == APPROACHING) {
+        SleepUntilPlayable(o, time);
+        return;
+    }
+    if (state_ != PLAYABLE && state_ != BEING_PLAYED) {
+        o->Sleep(Component::VERTICAL_COLLISION_DETECTOR);
+        o->Sleep(GetType());
+        return;
     }
 
-    auto note = o->GetComponent<NoteInfoComponent>(Component::NOTE_INFO);
-    if (!note) {
+    // Start or stop playing as the instrument is pressed and released
+    if (state_ == PLAYABLE && instrument_) {
+        StartPlaying(g, o, instrument_);
+    } else if (state_ == BEING_PLAYED && !instrument_) {
+        StopPlaying();
+    }
+    if (state_ != BEING_PLAYED) {
+        return;
+    }
+
+    // The part of the note that has reached the instrument has been played,
+    // so the note is cut off one pixel into the instrument. Once all of it
+    // has been played, we're done.
+    double x, y, width, height;
+    o->GetPosition(&x, &y);
+    o->GetSize(&width, &height);
+    if (y < instrument_y_) {
+        o->SetSize(width, std::min(height, instrument_y_ - y + 1));
+    } else {
+        StopPlaying();
+        o->SetSize(0, 0);
+        state_ = DONE;
+        o->Sleep(Component::VERTICAL_COLLISION_DETECTOR);
+        o->Sleep(GetType());
+    }
+}
+
+bool PianoSongNoteCollisionHandlerComponent::InitThresholds(Game* g, GameObject*
+        o) {
+    auto physics = o->GetComponent<PhysicsComponent>(Component::PHYSICS);
+    if (!physics) {
         return false;
     }
-    auto other_note = collider->GetComponent<NoteInfoComponent>(
-            Component::NOTE_INFO);
-    // Check it's the correct instrument - we may collide with
-    // neighbouring instruments if they overlap on the screen.
-    if (!other_note || other_note->GetKey() != note->GetKey()) {
+    double x_vel, y_vel;
+    physics->GetVelocity(&x_vel, &y_vel);
+    if (y_vel <= 0) {
         return false;
     }
 
-    // Get position and size info
+    // Notes only move by falling, so we can work out when they will reach
+    // each threshold from where they are now
     double x, y, width, height;
     o->GetPosition(&x, &y);
     o->GetSize(&width, &height);
-    double inst_x, inst_y, inst_w, inst_h;
-    collider->GetPosition(&inst_x, &inst_y);
-    collider->GetSize(&inst_w, &inst_h);
+    playable_time_ = (instrument_y_ - (y + height)) / y_vel;
+    missed_time_ = (instrument_y_ + NOTE_COLLISION_CUTOFF - y) / y_vel;
+    timers_ = &g->GetTimers();
+    start_time_ = timers_->GetTime();
+    has_thresholds_ = true;
+    return true;
+}
 
-    // Check if the note is in the playable part of the insrtument.
-    if (y > inst_y + NOTE_COLLISION_CUTOFF) {
-        return false;
+void PianoSongNoteCollisionHandlerComponent::SleepUntilPlayable(
+        GameObject* o
+        , double time) {
+    if (wake_timer_ != TimerWheel::NO_TIMER) {
+        return;
     }
+    o->Sleep(Component::VERTICAL_COLLISION_DETECTOR);
+    o->Sleep(GetType());
+    wake_timer_ = timers_->Schedule(static_cast<int>(std::ceil(playable_time_
+                    - time)), [this, o] {
+        wake_timer_ = TimerWheel::NO_TIMER;
+        o->Wake(Component::VERTICAL_COLLISION_DETECTOR);
+        o->Wake(GetType());
+    });
+}
 
+void PianoSongNoteCollisionHandlerComponent::StartPlaying(
+        Game* g
+        , GameObject* o
+        , GameObject* instrument) {
     // If the bottom of the note is outside the playable part, separate the
     // part below the cutoff in to a different (unplayable) note. This section
     // of the note has been missed.
-    if (y + height > inst_y + NOTE_COLLISION_CUTOFF) {
-        auto note = o->GetComponent<NoteInfoComponent>(
-                Component::NOTE_INFO);
-        if (!note) {
-            return true;
-        }
-
+    double x, y, width, height;
+    o->GetPosition(&x, &y);
+    o->GetSize(&width, &height);
+    double cutoff = instrument_y_ + NOTE_COLLISION_CUTOFF;
+    auto note = o->GetComponent<NoteInfoComponent>(Component::NOTE_INFO);
+    if (note && y + height > cutoff) {
         GameObject* half = g->GetGameObjectFactory().CreateSongNote(
                     note->GetTrack()
                     , note->GetChannel()
@@ -114,25 +186,58 @@ bool PianoSongNoteCollisionHandlerComponent::HandleCollision(
         // We don't want complete note behaviour - this is an
         // unplayable note
         half->DeleteComponent(Component::NOTE_COLLISION_HANDLER);
-        half->SetPosition(x, inst_y + NOTE_COLLISION_CUTOFF);
-        half->SetSize(width, (y + height) - (inst_y
-                    + NOTE_COLLISION_CUTOFF));
+        half->DeleteComponent(Component::VERTICAL_COLLISION_DETECTOR);
+        half->SetPosition(x, cutoff);
+        half->SetSize(width, y + height - cutoff);
         g->AddGameObject(half);
     }
 
-    // Now we are guaranteed to have a note that ends before the bottom
-    // of the instrument (see above).
-    //
-    // If the top of the note is before the instrument:
-    if (y < inst_y) {
-        // Resize the note so that it is intersecting with the instrument by
-        // one pixel
-        o->SetComponent(new ResizeComponent{width, inst_y-y + 1});
-    } else {  // Otherwise 'o' is now purely within the instrument and
-             // can be removed.
-        o->SetComponent(new ResizeComponent{0, 0});
+    // Add a grinding effect while the note is being played
+    state_ = BEING_PLAYED;
+    EffectSystem::Effect effect;
+    if (g->GetGameObjectFactory().CreateNotePlayEffect(instrument, &effect)) {
+        game_ = g;
+        grinding_ = g->GetEffectSystem().Add(effect);
+    }
+    // The note was due when it reached the instrument, which is known exactly
+    // however long the ticks were
+    g->RecordNoteHit(instrument, start_time_ + playable_time_);
+}
+
+void PianoSongNoteCollisionHandlerComponent::StopPlaying() {
+    if (game_) {
+        game_->RemoveEffect(grinding_);
+    }
+    grinding_ = EffectSystem::NO_EFFECT;
+    state_ = PLAYABLE;
+}
+
+void PianoSongNoteCollisionHandlerComponent::UpdateInstrument(
+        GameObject* o
+        , const VerticalCollisionDetectorComponent& contacts) {
+    // Instruments are only collidable while they are being played, so they
+    // exit when released
+    if (contacts.GetExited().Contains(instrument_)) {
+        instrument_ = nullptr;
+    }
+
+    auto note = o->GetComponent<NoteInfoComponent>(Component::NOTE_INFO);
+    if (!note) {
+        return;
+    }
+    for (auto& collider : contacts.GetEntered()) {
+        if (!collider->HasComponent(Component::INSTRUMENT)) {
+            continue;
+        }
+
+        // Check it's the correct instrument - we may collide with
+        // neighbouring instruments if they overlap on the screen.
+        auto other_note = collider->GetComponent<NoteInfoComponent>(
+                Component::NOTE_INFO);
+        if (other_note && other_note->GetKey() == note->GetKey()) {
+            instrument_ = collider;
+        }
     }
-    return true;
 }
 
 }  // End namespace midistar
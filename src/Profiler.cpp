@@ -0,0 +1,133 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midistar/Profiler.h"
+
+#include <algorithm>
+#include <map>
+
+namespace midistar {
+
+Profiler::Profiler()
+        : clock_{}
+        , counters_{}
+        , enabled_{false}
+        , samples_{} {
+}
+
+int Profiler::AddCounter(const std::string& name) {
+    counters_.push_back({name, 0, 0, 0, 0});
+    return counters_.size() - 1;
+}
+
+void Profiler::BeginFrame() {
+    clock_.restart();
+}
+
+void Profiler::EndFrame(int num_objects, int num_song_notes) {
+    if (!enabled_) {
+        return;
+    }
+    samples_.push_back({clock_.getElapsedTime().asMicroseconds(), num_objects
+            , num_song_notes});
+}
+
+const std::vector<Profiler::FrameSample>& Profiler::GetFrameSamples() const {
+    return samples_;
+}
+
+bool Profiler::IsEnabled() const {
+    return enabled_;
+}
+
+void Profiler::Reset() {
+    samples_.clear();
+    for (auto& c : counters_) {
+        c = {c.name, 0, 0, 0, 0};
+    }
+}
+
+void Profiler::SetCounter(int id, sf::Int64 value) {
+    if (!enabled_) {
+        return;
+    }
+    auto& c = counters_[id];
+    c.last = value;
+    c.max = c.num_samples ? std::max(c.max, value) : value;
+    c.total += value;
+    ++c.num_samples;
+}
+
+void Profiler::SetEnabled(bool enabled) {
+    enabled_ = enabled;
+}
+
+void Profiler::WriteReport(std::ostream* out) const {
+    if (samples_.empty()) {
+        *out << "No frames recorded.\n";
+        return;
+    }
+
+    // Group frame times by the number of song notes on screen
+    std::vector<sf::Int64> all;
+    std::map<int, std::vector<sf::Int64>> buckets;
+    for (const auto& s : samples_) {
+        all.push_back(s.frame_time);
+        buckets[s.num_song_notes / SONG_NOTES_PER_BUCKET].push_back(
+                s.frame_time);
+    }
+
+    // Prints the frame count, mean, 50th percentile, 99th percentile and
+    // maximum of a group of frame times.
+    auto write_stats = [out](std::vector<sf::Int64>* times) {
+        std::sort(times->begin(), times->end());
+        sf::Int64 total = 0;
+        for (auto t : *times) {
+            total += t;
+        }
+        auto size = times->size();
+        *out << size << '\t' << total / static_cast<sf::Int64>(size) << '\t'
+            << (*times)[size / 2] << '\t' << (*times)[(size * 99) / 100]
+            << '\t' << times->back() << '\n';
+    };
+
+    *out << "song_notes\tframes\tmean_us\tp50_us\tp99_us\tmax_us\n";
+    for (auto& b : buckets) {
+        *out << b.first * SONG_NOTES_PER_BUCKET << '-' << (b.first + 1) *
+            SONG_NOTES_PER_BUCKET - 1 << '\t';
+        write_stats(&b.second);
+    }
+    *out << "all\t";
+    write_stats(&all);
+
+    // Counters that were never set are left out
+    bool header = false;
+    for (const auto& c : counters_) {
+        if (!c.num_samples) {
+            continue;
+        }
+        if (!header) {
+            *out << "counter\tlast\tmean\tmax\n";
+            header = true;
+        }
+        *out << c.name << '\t' << c.last << '\t' << c.total / c.num_samples
+            << '\t' << c.max << '\n';
+    }
+}
+
+}  // End namespace midistar
@@ -0,0 +1,110 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "midistar/RenderSnapshot.h"
+
+#include <cassert>
+
+namespace midistar {
+
+RenderSnapshot::RenderSnapshot()
+        : background_{sf::Color::Black}
+        , effect_vertices_{sf::Quads}
+        , effects_{nullptr}
+        , first_note_{0}
+        , note_layer_{nullptr}
+        , shapes_{}
+        , song_time_{0} {
+}
+
+void RenderSnapshot::AddEffects(EffectSystem* effects) {
+    effects->GetVertices(&effect_vertices_);
+    effects_ = effects;
+}
+
+void RenderSnapshot::AddObject(GameObject* o) {
+    auto rect = o->GetDrawformable<sf::RectangleShape>();
+    if (rect) {
+        AddShape(*rect, RECTANGLE, rect->getSize(), 0);
+        return;
+    }
+    auto circle = o->GetDrawformable<sf::CircleShape>();
+    assert(circle && "Only rectangles and circles can be captured");
+    if (circle) {
+        AddShape(*circle, CIRCLE, {circle->getRadius(), 0}, circle->
+                getPointCount());
+    }
+}
+
+void RenderSnapshot::Clear(const sf::Color& background) {
+    background_ = background;
+    effect_vertices_.clear();
+    effects_ = nullptr;
+    note_layer_ = nullptr;
+    shapes_.clear();
+}
+
+void RenderSnapshot::Draw(sf::RenderTarget* target) const {
+    target->clear(background_);
+    if (note_layer_) {
+        note_layer_->Draw(target, first_note_, song_time_);
+    }
+
+    // Shapes are drawn with one reused SFML shape of each kind
+    sf::CircleShape circle;
+    sf::RectangleShape rect;
+    for (const auto& s : shapes_) {
+        sf::Shape* shape = &rect;
+        if (s.type == CIRCLE) {
+            circle.setRadius(s.size.x);
+            circle.setPointCount(s.point_count);
+            shape = &circle;
+        } else {
+            rect.setSize(s.size);
+        }
+        shape->setFillColor(s.fill_colour);
+        shape->setOrigin(s.origin);
+        shape->setOutlineColor(s.outline_colour);
+        shape->setOutlineThickness(s.outline_thickness);
+        shape->setPosition(s.position);
+        shape->setRotation(s.rotation);
+        shape->setScale(s.scale);
+        target->draw(*shape);
+    }
+
+    if (effects_ && effect_vertices_.getVertexCount()) {
+        target->draw(effect_vertices_, &effects_->GetAtlas());
+    }
+}
+
+void RenderSnapshot::SetNoteLayer(NoteLayer* layer, std::size_t first, double
+        song_time) {
+    note_layer_ = layer;
+    first_note_ = first;
+    song_time_ = song_time;
+}
+
+void RenderSnapshot::AddShape(const sf::Shape& s, ShapeType type, const
+        sf::Vector2f& size, std::size_t point_count) {
+    shapes_.push_back({s.getFillColor(), s.getOutlineColor(), s.
+            getOutlineThickness(), s.getOrigin(), point_count, s.getPosition()
+            , s.getRotation(), s.getScale(), size, type});
+}
+
+}  // End namespace midistar
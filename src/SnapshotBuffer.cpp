@@ -16,31 +16,33 @@
  * this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "midistar/FadeOutEffectComponent.h"
 
-#include "midistar/ResizeComponent.h"
+#include "midistar/SnapshotBuffer.h"
 
 namespace midistar {
 
-FadeOutEffectComponent::FadeOutEffectComponent()
-        : Component{Component::FADING_OUTLINE_EFFECT} {
+SnapshotBuffer::SnapshotBuffer()
+        : back_{2}
+        , front_{0}
+        , middle_{1}
+        , snapshots_{} {
 }
 
-void FadeOutEffectComponent::Update(Game*, GameObject* o, int) {
-    auto shape = o->GetDrawformable<sf::Shape>();
-    if (!shape) {
-        return;
-    }
-    // Change the alpha of the colour, to dim the shape
-    auto colour = shape->getFillColor();
-    colour.a = static_cast<sf::Uint8>(colour.a
-        * FadeOutEffectComponent::ALPHA_MULTIPLIER);
-    shape->setFillColor(colour);
-
-    // If we're finished, delete the component
-    if (colour.a <= EPSILON) {
-        o->DeleteComponent(GetType());
+const RenderSnapshot& SnapshotBuffer::Acquire() {
+    if (middle_.load(std::memory_order_relaxed) & FRESH) {
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) &
+            INDEX_MASK;
     }
+    return snapshots_[front_];
+}
+
+RenderSnapshot& SnapshotBuffer::GetBack() {
+    return snapshots_[back_];
+}
+
+void SnapshotBuffer::Publish() {
+    back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) &
+        INDEX_MASK;
 }
 
 }  // End namespace midistar
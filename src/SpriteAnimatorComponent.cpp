@@ -27,19 +27,34 @@ SpriteAnimatorComponent::SpriteAnimatorComponent(
     , int fps)
         : Component{Component::SPRITE_ANIMATOR}
         , col_{col}
-        , last_frame_delta_{0}
         , ms_per_frame_{1000 / fps}
         , row_{row}
-        , sprite_size_{sprite_size} {
+        , sprite_size_{sprite_size}
+        , timer_{TimerWheel::NO_TIMER}
+        , timers_{nullptr} {
 }
 
-void SpriteAnimatorComponent::Update(Game*, GameObject* o, int delta) {
-    // We only update X frames per second
-    last_frame_delta_ += delta;
-    if (last_frame_delta_ < ms_per_frame_) {
-        return;
+SpriteAnimatorComponent::~SpriteAnimatorComponent() {
+    if (timers_) {
+        timers_->Cancel(timer_);
     }
-    last_frame_delta_ = 0;
+}
+
+void SpriteAnimatorComponent::Update(Game* g, GameObject* o, int) {
+    // Frames are changed by the timer, so we sleep once the animation has
+    // started
+    timers_ = &g->GetTimers();
+    timer_ = timers_->Schedule(ms_per_frame_, [this, o] {
+        NextFrame(o);
+    });
+    o->Sleep(GetType());
+}
+
+void SpriteAnimatorComponent::NextFrame(GameObject* o) {
+    // We only update X frames per second
+    timer_ = timers_->Schedule(ms_per_frame_, [this, o] {
+        NextFrame(o);
+    });
 
     // We can only operate on GameObjects that actually have a sprite
     auto sprite = o->GetDrawformable<sf::Sprite>();
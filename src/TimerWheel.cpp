@@ -0,0 +1,160 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midistar/TimerWheel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace midistar {
+
+TimerWheel::TimerWheel()
+        : count_{0}
+        , free_timers_{}
+        , heads_{}
+        , tails_{}
+        , time_{0}
+        , timers_{} {
+    std::fill(std::begin(heads_), std::end(heads_), NO_TIMER);
+    std::fill(std::begin(tails_), std::end(tails_), NO_TIMER);
+}
+
+void TimerWheel::Advance(int delta) {
+    // Once there are no timers, nothing can come due, so we don't need to
+    // visit any more slots
+    for (; delta > 0 && count_; --delta) {
+        ++time_;
+
+        // When the lowest level wraps around, the next slot of the level above
+        // is moved down, and so on up the wheel
+        for (int level = 1; level < NUM_LEVELS; ++level) {
+            if ((time_ >> (LEVEL_BITS * (level - 1))) & SLOT_MASK) {
+                break;
+            }
+            Cascade(level);
+        }
+
+        // Every timer in the current lowest level slot is due. Functions may
+        // add and cancel timers, so we take timers from the slot one at a time.
+        int slot = time_ & SLOT_MASK;
+        while (heads_[slot] != NO_TIMER) {
+            int id = heads_[slot];
+            Unlink(id);
+            Callback callback{std::move(timers_[id].callback)};
+            timers_[id].callback = nullptr;
+            timers_[id].live = false;
+            free_timers_.push_back(id);
+            --count_;
+            callback();
+        }
+    }
+    time_ += std::max(delta, 0);
+}
+
+void TimerWheel::Cancel(int id) {
+    if (id == NO_TIMER || !timers_[id].live) {
+        return;
+    }
+    Unlink(id);
+    timers_[id].callback = nullptr;
+    timers_[id].live = false;
+    free_timers_.push_back(id);
+    --count_;
+}
+
+int TimerWheel::GetCount() const {
+    return count_;
+}
+
+int TimerWheel::GetTime() const {
+    return time_;
+}
+
+int TimerWheel::Schedule(int delay, Callback callback) {
+    int id;
+    if (!free_timers_.empty()) {
+        id = free_timers_.back();
+        free_timers_.pop_back();
+    } else {
+        id = timers_.size();
+        timers_.push_back({});
+    }
+
+    auto& timer = timers_[id];
+    timer.callback = std::move(callback);
+    timer.deadline = time_ + std::max(delay, 1);
+    timer.live = true;
+    ++count_;
+    Insert(id);
+    return id;
+}
+
+void TimerWheel::Cascade(int level) {
+    int slot = level * SLOTS_PER_LEVEL + ((time_ >> (LEVEL_BITS * level)) &
+            SLOT_MASK);
+    while (heads_[slot] != NO_TIMER) {
+        int id = heads_[slot];
+        Unlink(id);
+        Insert(id);
+    }
+}
+
+void TimerWheel::Insert(int id) {
+    auto& timer = timers_[id];
+
+    // Timers further away than the wheel can hold are placed in the furthest
+    // slot, and placed again when it cascades. Timers that cascade on their
+    // deadline go in the current slot, which is called straight after.
+    int delay = std::min(std::max(timer.deadline - time_, 0), MAX_DELAY);
+    int expires = time_ + delay;
+
+    int level = 0;
+    while (level < NUM_LEVELS - 1 && delay >= 1 << (LEVEL_BITS * (level +
+                    1))) {
+        ++level;
+    }
+    timer.slot = level * SLOTS_PER_LEVEL + ((expires >> (LEVEL_BITS * level))
+            & SLOT_MASK);
+
+    // Timers are added to the back of their slot, so timers with the same
+    // deadline are called in the order they were scheduled
+    timer.next = NO_TIMER;
+    timer.prev = tails_[timer.slot];
+    if (timer.prev != NO_TIMER) {
+        timers_[timer.prev].next = id;
+    } else {
+        heads_[timer.slot] = id;
+    }
+    tails_[timer.slot] = id;
+}
+
+void TimerWheel::Unlink(int id) {
+    auto& timer = timers_[id];
+    if (timer.prev != NO_TIMER) {
+        timers_[timer.prev].next = timer.next;
+    } else {
+        heads_[timer.slot] = timer.next;
+    }
+    if (timer.next != NO_TIMER) {
+        timers_[timer.next].prev = timer.prev;
+    } else {
+        tails_[timer.slot] = timer.prev;
+    }
+}
+
+}  // End namespace midistar
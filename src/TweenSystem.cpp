@@ -0,0 +1,291 @@
+/*
+ * midistar
+ * Copyright (C) 2018-2019 Jeremy Collette.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midistar/TweenSystem.h"
+
+#include <algorithm>
+
+namespace midistar {
+
+TweenSystem::TweenSystem()
+        : curves_{}
+        , durations_{}
+        , effect_ids_{}
+        , effect_systems_{}
+        , elapsed_{}
+        , ends_{}
+        , faded_{}
+        , objects_{}
+        , properties_{}
+        , shapes_{}
+        , starts_{}
+        , values_{} {
+}
+
+bool TweenSystem::Add(
+        GameObject* o
+        , Property property
+        , float end
+        , int duration
+        , Easing easing) {
+    auto shape = o->GetDrawformable<sf::Shape>();
+    double width, height;
+    float start = 0;
+    switch (property) {
+        case WIDTH:
+        case HEIGHT:
+            o->GetSize(&width, &height);
+            start = static_cast<float>(property == WIDTH ? width : height);
+            break;
+        case ALPHA:
+            if (!shape) {
+                return false;
+            }
+            start = shape->getFillColor().a;
+            break;
+        case OUTLINE_THICKNESS:
+            if (!shape) {
+                return false;
+            }
+            start = shape->getOutlineThickness();
+            break;
+    }
+
+    auto i = Insert(o, nullptr, EffectSystem::NO_EFFECT, property, start, end
+            , duration, easing);
+    shapes_[i] = shape;
+    return true;
+}
+
+bool TweenSystem::Add(
+        EffectSystem* effects
+        , int effect
+        , Property property
+        , float end
+        , int duration
+        , Easing easing) {
+    const auto& e = effects->Get(effect);
+    float start = 0;
+    switch (property) {
+        case WIDTH:
+            start = e.width;
+            break;
+        case HEIGHT:
+            start = e.height;
+            break;
+        case ALPHA:
+            start = e.colour.a;
+            break;
+        case OUTLINE_THICKNESS:
+            return false;
+    }
+    Insert(nullptr, effects, effect, property, start, end, duration, easing);
+    return true;
+}
+
+void TweenSystem::Clear() {
+    Resize(0);
+}
+
+int TweenSystem::GetCount() const {
+    return objects_.size();
+}
+
+void TweenSystem::Remove(GameObject* o) {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < objects_.size(); ++i) {
+        if (objects_[i] != o) {
+            Move(i, size++);
+        }
+    }
+    Resize(size);
+}
+
+void TweenSystem::Remove(EffectSystem* effects, int effect) {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < objects_.size(); ++i) {
+        if (effect_systems_[i] != effects || effect_ids_[i] != effect) {
+            Move(i, size++);
+        }
+    }
+    Resize(size);
+}
+
+void TweenSystem::Update(int delta) {
+    std::size_t count = objects_.size();
+    if (!count) {
+        return;
+    }
+
+    // Work out every value in one loop over plain arrays, so the compiler can
+    // vectorise it
+    float d = static_cast<float>(delta);
+    const float* curves = curves_.data();
+    const float* durations = durations_.data();
+    float* elapsed = elapsed_.data();
+    const float* ends = ends_.data();
+    const float* starts = starts_.data();
+    float* values = values_.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        elapsed[i] = std::min(elapsed[i] + d, durations[i]);
+        float t = elapsed[i] / durations[i];
+        float eased = t + curves[i] * t * (1.0f - t);
+        values[i] = starts[i] + (ends[i] - starts[i]) * eased;
+    }
+
+    // Set the properties, and keep the tweens that haven't finished
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        Apply(i);
+        if (elapsed_[i] < durations_[i]) {
+            Move(i, size++);
+        } else if (effect_systems_[i] && properties_[i] == ALPHA &&
+                values_[i] <= 0) {
+            faded_.push_back({effect_systems_[i], effect_ids_[i]});
+        }
+    }
+    Resize(size);
+
+    // Effects that have faded out are invisible, so they are removed along
+    // with any tweens they still have
+    for (const auto& f : faded_) {
+        Remove(f.first, f.second);
+        f.first->Remove(f.second);
+    }
+    faded_.clear();
+}
+
+void TweenSystem::Apply(std::size_t i) {
+    float value = values_[i];
+    if (effect_systems_[i]) {
+        // Effects grow and shrink around their centre
+        auto& e = effect_systems_[i]->Get(effect_ids_[i]);
+        switch (properties_[i]) {
+            case WIDTH:
+                e.x -= (value - e.width) / 2.0f;
+                e.width = value;
+                break;
+            case HEIGHT:
+                e.y -= (value - e.height) / 2.0f;
+                e.height = value;
+                break;
+            case ALPHA:
+                e.colour.a = static_cast<sf::Uint8>(std::min(std::max(value
+                                , 0.0f), 255.0f));
+                break;
+            case OUTLINE_THICKNESS:
+                break;
+        }
+        return;
+    }
+
+    auto o = objects_[i];
+    auto shape = shapes_[i];
+    double width, height, x, y;
+    sf::Color colour;
+    switch (properties_[i]) {
+        case WIDTH:
+        case HEIGHT:
+            o->GetSize(&width, &height);
+            o->GetPosition(&x, &y);
+            if (properties_[i] == WIDTH) {
+                o->SetPosition(x - (value - width) / 2.0, y);
+                o->SetSize(value, height);
+            } else {
+                o->SetPosition(x, y - (value - height) / 2.0);
+                o->SetSize(width, value);
+            }
+            break;
+        case ALPHA:
+            colour = shape->getFillColor();
+            colour.a = static_cast<sf::Uint8>(std::min(std::max(value, 0.0f)
+                        , 255.0f));
+            shape->setFillColor(colour);
+            break;
+        case OUTLINE_THICKNESS:
+            shape->setOutlineThickness(value);
+            break;
+    }
+}
+
+std::size_t TweenSystem::Insert(
+        GameObject* o
+        , EffectSystem* effects
+        , int effect
+        , Property property
+        , float start
+        , float end
+        , int duration
+        , Easing easing) {
+    // Replace any tween of the same property
+    std::size_t i = 0;
+    while (i < objects_.size() && (objects_[i] != o || effect_systems_[i] !=
+                effects || effect_ids_[i] != effect || properties_[i] !=
+                property)) {
+        ++i;
+    }
+    if (i == objects_.size()) {
+        Resize(i + 1);
+    }
+
+    curves_[i] = easing == EASE_IN ? -1.0f : easing == EASE_OUT ? 1.0f : 0.0f;
+    durations_[i] = static_cast<float>(std::max(duration, 1));
+    effect_ids_[i] = effect;
+    effect_systems_[i] = effects;
+    elapsed_[i] = 0;
+    ends_[i] = end;
+    objects_[i] = o;
+    properties_[i] = property;
+    shapes_[i] = nullptr;
+    starts_[i] = start;
+    values_[i] = start;
+    return i;
+}
+
+void TweenSystem::Move(std::size_t from, std::size_t to) {
+    if (from == to) {
+        return;
+    }
+    curves_[to] = curves_[from];
+    durations_[to] = durations_[from];
+    effect_ids_[to] = effect_ids_[from];
+    effect_systems_[to] = effect_systems_[from];
+    elapsed_[to] = elapsed_[from];
+    ends_[to] = ends_[from];
+    objects_[to] = objects_[from];
+    properties_[to] = properties_[from];
+    shapes_[to] = shapes_[from];
+    starts_[to] = starts_[from];
+    values_[to] = values_[from];
+}
+
+void TweenSystem::Resize(std::size_t size) {
+    curves_.resize(size);
+    durations_.resize(size);
+    effect_ids_.resize(size);
+    effect_systems_.resize(size);
+    elapsed_.resize(size);
+    ends_.resize(size);
+    objects_.resize(size);
+    properties_.resize(size);
+    shapes_.resize(size);
+    starts_.resize(size);
+    values_.resize(size);
+}
+
+}  // End namespace midistar
@@ -18,6 +18,13 @@
 
 #include "midistar/Utility.h"
 
+#include <cstdlib>
+
+#ifdef __linux__
+#include <fstream>
+#include <unistd.h>
+#endif
+
 namespace midistar {
 
 const std::vector<sf::Keyboard::Key> Utility::qwerty_keys_{
@@ -51,6 +58,32 @@ const std::vector<sf::Keyboard::Key>& Utility::GetQwertyKeys() {
     return qwerty_keys_;
 }
 
+long long Utility::GetResidentMemory() {
+#ifdef __linux__
+    // The second field of statm is the number of resident pages
+    std::ifstream statm{"/proc/self/statm"};
+    long long size, resident;
+    if (statm >> size >> resident) {
+        return resident * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return -1;
+}
+
+std::string Utility::GetTempDirectory() {
+    for (auto name : {"TMPDIR", "TMP", "TEMP"}) {
+        auto dir = std::getenv(name);
+        if (dir && *dir) {
+            return dir;
+        }
+    }
+#ifdef _WIN32
+    return ".";
+#else
+    return "/tmp";
+#endif
+}
+
 const sf::Color Utility::DarkenColour(sf::Color c) {
     return Utility::TransformColour(c, Utility::COLOUR_DARKEN_MULTIPLIER);
 }
@@ -18,24 +18,44 @@
 
 #include "midistar/VerticalCollisionDetectorComponent.h"
 
+#include <algorithm>
+
 namespace midistar {
 
 VerticalCollisionDetectorComponent::VerticalCollisionDetectorComponent()
-        : Component{Component::VERTICAL_COLLISION_DETECTOR} {
+        : Component{Component::VERTICAL_COLLISION_DETECTOR}
+        , contacts_{}
+        , num_colliding_{0}
+        , num_entered_{0}
+        , previous_{} {
+}
+
+ContactSpan VerticalCollisionDetectorComponent::GetCollidingWith() const {
+    return {contacts_.data(), contacts_.data() + num_colliding_};
 }
 
-const std::vector<GameObject*>& VerticalCollisionDetectorComponent::
-        GetCollidingWith() {
-    return colliding_with_;
+ContactSpan VerticalCollisionDetectorComponent::GetEntered() const {
+    return {contacts_.data(), contacts_.data() + num_entered_};
 }
 
+ContactSpan VerticalCollisionDetectorComponent::GetExited() const {
+    return {contacts_.data() + num_colliding_, contacts_.data() +
+        contacts_.size()};
+}
 
-bool VerticalCollisionDetectorComponent::GetIsColliding() {
-    return GetCollidingWith().size();
+bool VerticalCollisionDetectorComponent::GetIsColliding() const {
+    return num_colliding_;
 }
 
 void VerticalCollisionDetectorComponent::Update(Game* g, GameObject* o, int) {
-    colliding_with_.clear();
+    // The last update's contacts become the previous contacts, and the old
+    // previous buffer is reused for this update
+    std::swap(contacts_, previous_);
+    auto prev_begin = previous_.begin();
+    auto prev_end = previous_.begin() + num_colliding_;
+    contacts_.clear();
+    num_entered_ = 0;
+
     for (auto& other_obj : g->GetGameObjects()) {
         if (other_obj == o ||
                 !other_obj->HasComponent(Component::COLLIDABLE)) {
@@ -59,7 +79,26 @@ void VerticalCollisionDetectorComponent::Update(Game* g, GameObject* o, int) {
         if ((y >= other_y && y <= other_y + other_h)
                  || (y + h >= other_y && y + h <= other_y + other_h)
                  || (y <= other_y && y + h >= other_y + other_h)) {
-            colliding_with_.push_back(other_obj);
+            // New contacts go before carried on contacts. Both keep Game
+            // order (rather than being sorted by address), so handlers see
+            // contacts in the same order each time a session is replayed.
+            if (std::find(prev_begin, prev_end, other_obj) == prev_end) {
+                contacts_.insert(contacts_.begin() + num_entered_++
+                        , other_obj);
+            } else {
+                contacts_.push_back(other_obj);
+            }
+        }
+    }
+    num_colliding_ = contacts_.size();
+
+    // Any previous contacts that aren't colliding now have exited
+    auto colliding_end = contacts_.begin() + num_colliding_;
+    for (auto it = prev_begin; it != prev_end; ++it) {
+        if (std::find(contacts_.begin(), colliding_end, *it) ==
+                colliding_end) {
+            contacts_.push_back(*it);
+            colliding_end = contacts_.begin() + num_colliding_;
         }
     }
 }
@@ -17,13 +17,25 @@
  */
 
 #include <iostream>
+#include <ostream>
 
+#include "midistar/Benchmark.h"
 #include "midistar/Config.h"
 #include "midistar/Game.h"
+#include "midistar/MidiFileGenerator.h"
+#include "midistar/OfflineRenderer.h"
 #include "midistar/Version.h"
 
 int main(int argc, char** argv) {
-    std::cout << "midistar " << MIDISTAR_VERSION << " Copyright (C) 2018-2019 "
+    if (!midistar::Config::GetInstance().ParseOptions(argc, argv)) {
+        return 1;
+    }
+
+    // Raw video frames may be written to standard output, in which case
+    // messages go to standard error
+    std::ostream& out = midistar::Config::GetInstance().GetRenderVideo() ==
+        "-" ? std::cerr : std::cout;
+    out << "midistar " << MIDISTAR_VERSION << " Copyright (C) 2018-2019 "
     << "Jeremy Collette.\nThis program comes with ABSOLUTELY NO WARRANTY. "
     << "This is free software, and you are welcome to redistribute it under "
     << "certain conditions. midistar uses free third-party software, that you "
@@ -31,13 +43,9 @@ int main(int argc, char** argv) {
     << "see each included third-party project and their copyright notices.\n\n";
 
 #ifdef DEBUG
-    std::cout << "This is a DEBUG build.\n\n";
+    out << "This is a DEBUG build.\n\n";
 #endif
 
-    if (!midistar::Config::GetInstance().ParseOptions(argc, argv)) {
-        return 1;
-    }
-
     if (midistar::Config::GetInstance().GetShowThirdParty()) {
         std::cout << "The following free third-party libraries and utilities "
             << "are used by (and distributed with) midistar:\n";
@@ -50,6 +58,25 @@ int main(int argc, char** argv) {
         return 0;
     }
 
+    auto generate_midi_file = midistar::Config::GetInstance().
+        GetGenerateMidiFile();
+    if (!generate_midi_file.empty()) {
+        midistar::MidiFileGenerator generator{midistar::Config::GetInstance().
+            GetMidiFileGeneratorParameters()};
+        return generator.Write(generate_midi_file) ? 0 : 3;
+    }
+
+    if (midistar::Config::GetInstance().GetBenchmark()) {
+        midistar::Benchmark benchmark;
+        return benchmark.Run() ? 0 : 4;
+    }
+
+    if (!midistar::Config::GetInstance().GetRenderVideo().empty()
+            || !midistar::Config::GetInstance().GetRenderAudio().empty()) {
+        midistar::OfflineRenderer renderer;
+        return renderer.Run() ? 0 : 5;
+    }
+
     midistar::Game g;
     if (!g.Init()) {
         return 2;